@@ -0,0 +1,239 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** MeshCache.cpp
+*/
+
+#include "MeshCache.hpp"
+#include "../utils/Debug.hpp"
+#include "../utils/FileStamp.hpp"
+#include "../utils/MappedFile.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace Raytracer {
+
+namespace {
+
+    constexpr char MAGIC[8] = { 'R', 'T', 'M', 'E', 'S', 'H', 0, 0 };
+    constexpr std::uint32_t VERSION = 1;
+    constexpr std::uint32_t ENDIAN_PROBE = 0x01020304;
+    // Sections start on cache line boundaries, which covers the alignment
+    // of every buffer type
+    constexpr std::size_t ALIGNMENT = 64;
+
+    enum SectionId {
+        X,
+        Y,
+        Z,
+        INDICES,
+        NORMAL_X,
+        NORMAL_Y,
+        NORMAL_Z,
+        NORMAL_INDICES,
+        FACE_NORMALS,
+        BLOCKS,
+        BVH_NODES,
+        BVH_INDICES,
+        SECTION_COUNT
+    };
+
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byteOrder;
+        std::uint32_t realSize;
+        std::uint32_t nodeSize;
+        FileStamp source;
+        double bounds[6]; // BVH bounds, min then max
+        std::uint64_t counts[SECTION_COUNT]; // Elements in each section
+    };
+
+    std::size_t elementSize(int section)
+    {
+        switch (section) {
+        case FACE_NORMALS:
+            return sizeof(Math::Vector3D);
+        case BLOCKS:
+            return sizeof(TriangleBlock);
+        case BVH_NODES:
+            return sizeof(BVH::Node);
+        case INDICES:
+        case NORMAL_INDICES:
+        case BVH_INDICES:
+            return sizeof(std::uint32_t);
+        default:
+            return sizeof(float);
+        }
+    }
+
+    std::size_t align(std::size_t offset)
+    {
+        return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    }
+
+    // Buffer to write, with its element count
+    struct Section {
+        const void* data;
+        std::size_t count;
+    };
+
+    // Views a section of the mapped file in place
+    template <typename T>
+    Buffer<T> mapSection(const std::shared_ptr<const MappedFile>& file,
+        std::size_t offset, std::uint64_t count)
+    {
+        return Buffer<T>(reinterpret_cast<const T*>(file->data() + offset), count, file);
+    }
+
+    // Writes mesh to path as the cache of the source file stamped source.
+    // Errors are logged and otherwise ignored, the cache only saves time.
+    void writeCache(const std::string& path, const FileStamp& source,
+        const MeshData& mesh)
+    {
+        Header header = {};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.byteOrder = ENDIAN_PROBE;
+        header.realSize = sizeof(Math::Real);
+        header.nodeSize = sizeof(BVH::Node);
+        header.source = source;
+
+        const MeshBuffers& buffers = mesh.getBuffers();
+        const AABB& bounds = buffers.bvh.getBounds();
+        const double values[6] = { bounds.min.x, bounds.min.y, bounds.min.z,
+            bounds.max.x, bounds.max.y, bounds.max.z };
+        std::memcpy(header.bounds, values, sizeof(values));
+
+        const Section sections[SECTION_COUNT] = {
+            { buffers.x.data(), buffers.x.size() },
+            { buffers.y.data(), buffers.y.size() },
+            { buffers.z.data(), buffers.z.size() },
+            { buffers.indices.data(), buffers.indices.size() },
+            { buffers.normalX.data(), buffers.normalX.size() },
+            { buffers.normalY.data(), buffers.normalY.size() },
+            { buffers.normalZ.data(), buffers.normalZ.size() },
+            { buffers.normalIndices.data(), buffers.normalIndices.size() },
+            { buffers.faceNormals.data(), buffers.faceNormals.size() },
+            { buffers.blocks.data(), buffers.blocks.size() },
+            { buffers.bvh.getNodes().data(), buffers.bvh.getNodes().size() },
+            { buffers.bvh.getIndices().data(), buffers.bvh.getIndices().size() },
+        };
+        for (int i = 0; i < SECTION_COUNT; i++)
+            header.counts[i] = sections[i].count;
+
+        // Written aside and renamed over the old cache, so that concurrent
+        // renders never map a half-written file
+        std::string temporary = path + ".tmp" + std::to_string(getpid());
+        std::ofstream out(temporary, std::ios::binary);
+        const char padding[ALIGNMENT] = {};
+        std::size_t offset = sizeof(header);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (int i = 0; i < SECTION_COUNT; i++) {
+            out.write(padding, align(offset) - offset);
+            offset = align(offset);
+            std::size_t size = sections[i].count * elementSize(i);
+            out.write(static_cast<const char*>(sections[i].data), size);
+            offset += size;
+        }
+        out.close();
+
+        if (!out || std::rename(temporary.c_str(), path.c_str()) != 0) {
+            Debug::log("Failed to write mesh cache: ", path);
+            std::remove(temporary.c_str());
+            return;
+        }
+        Debug::log("Wrote mesh cache: ", path);
+    }
+
+} // namespace
+
+std::string MeshCache::pathFor(const std::string& objPath)
+{
+    return objPath + ".rtmesh";
+}
+
+std::shared_ptr<const MeshData> MeshCache::load(const std::string& objPath)
+{
+    std::string path = pathFor(objPath);
+    if (access(path.c_str(), R_OK) != 0)
+        return nullptr;
+
+    try {
+        // Validating the tree reads every node, and meshes are traversed
+        // in no particular order afterwards
+        auto file = std::make_shared<const MappedFile>(path, MappedFile::Access::WillNeed);
+        Header header;
+        if (file->size() < sizeof(header))
+            return nullptr;
+        std::memcpy(&header, file->data(), sizeof(header));
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION
+            || header.byteOrder != ENDIAN_PROBE || header.realSize != sizeof(Math::Real)
+            || header.nodeSize != sizeof(BVH::Node)) {
+            Debug::log("Ignoring stale mesh cache: ", path);
+            return nullptr;
+        }
+
+        std::size_t offsets[SECTION_COUNT];
+        std::size_t end = align(sizeof(header));
+        for (int i = 0; i < SECTION_COUNT; i++) {
+            if (end > file->size() || header.counts[i] > (file->size() - end) / elementSize(i))
+                throw std::invalid_argument("Truncated mesh cache");
+            offsets[i] = end;
+            end = align(end + header.counts[i] * elementSize(i));
+        }
+
+        std::int64_t recordedTime = header.source.time;
+        if (!header.source.matches(objPath)) {
+            Debug::log("Ignoring stale mesh cache: ", path);
+            return nullptr;
+        }
+        const std::uint64_t* counts = header.counts;
+        MeshBuffers buffers;
+        buffers.x = mapSection<float>(file, offsets[X], counts[X]);
+        buffers.y = mapSection<float>(file, offsets[Y], counts[Y]);
+        buffers.z = mapSection<float>(file, offsets[Z], counts[Z]);
+        buffers.indices = mapSection<std::uint32_t>(file, offsets[INDICES], counts[INDICES]);
+        buffers.normalX = mapSection<float>(file, offsets[NORMAL_X], counts[NORMAL_X]);
+        buffers.normalY = mapSection<float>(file, offsets[NORMAL_Y], counts[NORMAL_Y]);
+        buffers.normalZ = mapSection<float>(file, offsets[NORMAL_Z], counts[NORMAL_Z]);
+        buffers.normalIndices = mapSection<std::uint32_t>(file, offsets[NORMAL_INDICES],
+            counts[NORMAL_INDICES]);
+        buffers.faceNormals = mapSection<Math::Vector3D>(file, offsets[FACE_NORMALS],
+            counts[FACE_NORMALS]);
+        buffers.blocks = mapSection<TriangleBlock>(file, offsets[BLOCKS], counts[BLOCKS]);
+        buffers.bvh.restore(mapSection<BVH::Node>(file, offsets[BVH_NODES], counts[BVH_NODES]),
+            mapSection<std::uint32_t>(file, offsets[BVH_INDICES], counts[BVH_INDICES]),
+            AABB(Math::Point3D(header.bounds[0], header.bounds[1], header.bounds[2]),
+                Math::Point3D(header.bounds[3], header.bounds[4], header.bounds[5])),
+            counts[INDICES] / 3);
+
+        auto mesh = std::make_shared<const MeshData>(std::move(buffers));
+        // Record the new time through a fresh file, the mapping keeps
+        // reading the old one
+        if (header.source.time != recordedTime)
+            writeCache(path, header.source, *mesh);
+        return mesh;
+    } catch (const std::exception& e) {
+        Debug::log("Ignoring invalid mesh cache ", path, ": ", e.what());
+        return nullptr;
+    }
+}
+
+void MeshCache::save(const std::string& objPath, const MeshData& mesh)
+{
+    FileStamp source;
+    try {
+        source = FileStamp::of(objPath);
+    } catch (const std::exception& e) {
+        Debug::log("Not caching mesh ", objPath, ": ", e.what());
+        return;
+    }
+    writeCache(pathFor(objPath), source, mesh);
+}
+
+} // namespace Raytracer
@@ -0,0 +1,40 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** MeshCache.hpp
+*/
+
+#ifndef RAYTRACER_MESHCACHE_HPP
+#define RAYTRACER_MESHCACHE_HPP
+
+#include "../core/MeshData.hpp"
+#include <memory>
+#include <string>
+
+namespace Raytracer {
+
+// Binary copy of a loaded OBJ mesh, kept next to it as "<file>.rtmesh".
+// It holds the vertex, index, normal and BVH buffers as they are laid out
+// in memory, so loading it maps the file and uses the buffers in place
+// instead of parsing the text and building the BVH again.
+// A cache belongs to the source file whose size, modification time and
+// content hash it records. When only the time differs (after a copy or a
+// checkout) the hash decides, and a match refreshes the recorded time.
+// Files are written for the build that reads them: a cache written with
+// another scalar type or node layout is treated as stale.
+class MeshCache {
+public:
+    static std::string pathFor(const std::string& objPath);
+
+    // Mesh cached for objPath, nullptr when there is no valid cache
+    static std::shared_ptr<const MeshData> load(const std::string& objPath);
+
+    // Writes the cache of objPath. Errors are logged and otherwise ignored,
+    // the cache only saves time.
+    static void save(const std::string& objPath, const MeshData& mesh);
+};
+
+} // namespace Raytracer
+
+#endif /* RAYTRACER_MESHCACHE_HPP */
@@ -0,0 +1,331 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** ObjLoader.cpp
+*/
+
+#include "ObjLoader.hpp"
+#include "../utils/MappedFile.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+namespace Raytracer {
+
+namespace {
+
+    // Corner that can never resolve to a valid index
+    constexpr std::int64_t MISSING = -1;
+
+    // What one thread reads from its slice of the file. Corners are stored
+    // triangulated, as 0-based indices. A negative OBJ index is relative to
+    // the vertices read so far, so it is stored relative to the chunk's
+    // first vertex and its position kept until the chunks before it have
+    // been counted.
+    struct Chunk {
+        std::vector<float> x, y, z;
+        std::vector<float> nx, ny, nz;
+        std::vector<std::int64_t> vertices;
+        std::vector<std::int64_t> normals;
+        std::vector<std::size_t> relativeVertices;
+        std::vector<std::size_t> relativeNormals;
+
+        std::vector<std::uint32_t> indices;
+        std::vector<std::uint32_t> normalIndices;
+        std::size_t invalidFaces = 0;
+    };
+
+    struct Corner {
+        std::int64_t vertex;
+        std::int64_t normal;
+        bool relativeVertex;
+        bool relativeNormal;
+    };
+
+    bool isSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    const char* skipSpaces(const char* p, const char* end)
+    {
+        while (p < end && isSpace(*p))
+            p++;
+        return p;
+    }
+
+    // Missing or malformed components read as 0
+    const char* parseFloat(const char* p, const char* end, float& value)
+    {
+        value = 0;
+        p = skipSpaces(p, end);
+        if (p < end && *p == '+')
+            p++;
+        auto result = std::from_chars(p, end, value);
+        if (result.ec == std::errc::result_out_of_range)
+            value = 0;
+        return result.ptr;
+    }
+
+    // OBJ index to a 0-based one, relative to count for negative indices
+    std::int64_t resolve(std::int64_t index, std::size_t count, bool& relative)
+    {
+        relative = index < 0;
+        if (index > 0)
+            return index - 1;
+        if (index < 0)
+            return static_cast<std::int64_t>(count) + index;
+        return MISSING;
+    }
+
+    // "v", "v/vt", "v//vn" or "v/vt/vn"
+    const char* parseCorner(const char* p, const char* end, const Chunk& chunk,
+        Corner& corner)
+    {
+        std::int64_t index = 0;
+        auto result = std::from_chars(p, end, index);
+        corner.vertex = resolve(index, chunk.x.size(), corner.relativeVertex);
+        corner.normal = MISSING;
+        corner.relativeNormal = false;
+        p = result.ptr;
+
+        if (p < end && *p == '/') {
+            p++;
+            while (p < end && *p != '/' && !isSpace(*p))
+                p++;
+            if (p < end && *p == '/') {
+                index = 0;
+                result = std::from_chars(p + 1, end, index);
+                corner.normal = resolve(index, chunk.nx.size(), corner.relativeNormal);
+                p = result.ptr;
+            }
+        }
+        while (p < end && !isSpace(*p))
+            p++;
+        return p;
+    }
+
+    void addCorner(Chunk& chunk, const Corner& corner)
+    {
+        if (corner.relativeVertex)
+            chunk.relativeVertices.push_back(chunk.vertices.size());
+        if (corner.relativeNormal)
+            chunk.relativeNormals.push_back(chunk.normals.size());
+        chunk.vertices.push_back(corner.vertex);
+        chunk.normals.push_back(corner.normal);
+    }
+
+    void parseFace(const char* p, const char* end, Chunk& chunk,
+        std::vector<Corner>& polygon)
+    {
+        polygon.clear();
+        for (p = skipSpaces(p, end); p < end; p = skipSpaces(p, end)) {
+            Corner corner;
+            p = parseCorner(p, end, chunk, corner);
+            polygon.push_back(corner);
+        }
+        if (polygon.size() < 3) {
+            chunk.invalidFaces++;
+            return;
+        }
+
+        // Fan around the first corner, which keeps the winding order
+        for (std::size_t i = 1; i + 1 < polygon.size(); i++) {
+            addCorner(chunk, polygon[0]);
+            addCorner(chunk, polygon[i]);
+            addCorner(chunk, polygon[i + 1]);
+        }
+    }
+
+    void parseChunk(const char* p, const char* end, Chunk& chunk)
+    {
+        std::vector<Corner> polygon;
+
+        while (p < end) {
+            const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+            if (!eol)
+                eol = end;
+            const char* line = skipSpaces(p, eol);
+            p = eol + 1;
+
+            // Anything after a '#' is a comment, even at the end of a line
+            const char* comment = static_cast<const char*>(std::memchr(line, '#', eol - line));
+            if (comment)
+                eol = comment;
+
+            std::size_t length = eol - line;
+            if (length >= 2 && line[0] == 'v' && isSpace(line[1])) {
+                float x, y, z;
+                line = parseFloat(line + 1, eol, x);
+                line = parseFloat(line, eol, y);
+                parseFloat(line, eol, z);
+                chunk.x.push_back(x);
+                chunk.y.push_back(y);
+                chunk.z.push_back(z);
+            } else if (length >= 3 && line[0] == 'v' && line[1] == 'n' && isSpace(line[2])) {
+                float x, y, z;
+                line = parseFloat(line + 2, eol, x);
+                line = parseFloat(line, eol, y);
+                parseFloat(line, eol, z);
+                chunk.nx.push_back(x);
+                chunk.ny.push_back(y);
+                chunk.nz.push_back(z);
+            } else if (length >= 2 && line[0] == 'f' && isSpace(line[1])) {
+                parseFace(line + 1, eol, chunk, polygon);
+            }
+        }
+    }
+
+    // Turns the corners of a chunk into final indices, once the number of
+    // vertices and normals in the chunks before it is known
+    void resolveChunk(Chunk& chunk, std::size_t firstVertex,
+        std::size_t firstNormal, std::size_t vertexCount, std::size_t normalCount)
+    {
+        for (std::size_t i : chunk.relativeVertices)
+            chunk.vertices[i] += static_cast<std::int64_t>(firstVertex);
+        for (std::size_t i : chunk.relativeNormals)
+            chunk.normals[i] += static_cast<std::int64_t>(firstNormal);
+
+        auto valid = [](std::int64_t index, std::size_t count) {
+            return index >= 0 && static_cast<std::uint64_t>(index) < count;
+        };
+
+        chunk.indices.reserve(chunk.vertices.size());
+        if (normalCount > 0)
+            chunk.normalIndices.reserve(chunk.normals.size());
+        for (std::size_t i = 0; i < chunk.vertices.size(); i += 3) {
+            const std::int64_t* face = &chunk.vertices[i];
+            if (!valid(face[0], vertexCount) || !valid(face[1], vertexCount)
+                || !valid(face[2], vertexCount)) {
+                chunk.invalidFaces++;
+                continue;
+            }
+            for (int corner = 0; corner < 3; corner++)
+                chunk.indices.push_back(static_cast<std::uint32_t>(face[corner]));
+            if (normalCount == 0)
+                continue;
+            for (int corner = 0; corner < 3; corner++) {
+                std::int64_t normal = chunk.normals[i + corner];
+                chunk.normalIndices.push_back(valid(normal, normalCount)
+                        ? static_cast<std::uint32_t>(normal)
+                        : MeshNormals::NONE);
+            }
+        }
+
+        chunk.vertices = {};
+        chunk.normals = {};
+        chunk.relativeVertices = {};
+        chunk.relativeNormals = {};
+    }
+
+    template <typename T>
+    void append(std::vector<T>& to, const std::vector<T>& from)
+    {
+        to.insert(to.end(), from.begin(), from.end());
+    }
+
+    // Runs task(0) .. task(count - 1), one thread each, the first one on
+    // the calling thread
+    template <typename Task>
+    void runParallel(std::size_t count, Task task)
+    {
+        std::vector<std::thread> threads;
+        threads.reserve(count);
+        for (std::size_t i = 1; i < count; i++)
+            threads.emplace_back(task, i);
+        task(0);
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+} // namespace
+
+ObjMesh ObjLoader::load(const std::string& path, int threads)
+{
+    MappedFile file(path);
+    try {
+        return parse(file.data(), file.size(), threads);
+    } catch (const std::runtime_error& e) {
+        throw std::runtime_error(std::string(e.what()) + ": " + path);
+    }
+}
+
+ObjMesh ObjLoader::parse(const char* data, std::size_t size, int threads)
+{
+    if (threads <= 0)
+        threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    std::size_t chunkCount = std::min(static_cast<std::size_t>(threads),
+        std::max<std::size_t>(1, size / MIN_CHUNK_SIZE));
+
+    // Chunk i covers [bounds[i], bounds[i + 1]), each cut placed just after
+    // a newline
+    std::vector<std::size_t> bounds(chunkCount + 1, size);
+    bounds[0] = 0;
+    for (std::size_t i = 1; i < chunkCount; i++) {
+        std::size_t cut = std::max(bounds[i - 1], size / chunkCount * i);
+        const void* eol = cut < size ? std::memchr(data + cut, '\n', size - cut) : nullptr;
+        bounds[i] = eol ? static_cast<const char*>(eol) - data + 1 : size;
+    }
+
+    std::vector<Chunk> chunks(chunkCount);
+    runParallel(chunkCount, [&](std::size_t i) {
+        parseChunk(data + bounds[i], data + bounds[i + 1], chunks[i]);
+    });
+
+    std::vector<std::size_t> firstVertex(chunkCount), firstNormal(chunkCount);
+    std::size_t vertexCount = 0, normalCount = 0;
+    for (std::size_t i = 0; i < chunkCount; i++) {
+        firstVertex[i] = vertexCount;
+        firstNormal[i] = normalCount;
+        vertexCount += chunks[i].x.size();
+        normalCount += chunks[i].nx.size();
+    }
+    if (vertexCount > std::numeric_limits<std::uint32_t>::max()
+        || normalCount >= MeshNormals::NONE)
+        throw std::runtime_error("Too many vertices in OBJ file");
+
+    runParallel(chunkCount, [&](std::size_t i) {
+        resolveChunk(chunks[i], firstVertex[i], firstNormal[i], vertexCount, normalCount);
+    });
+
+    ObjMesh mesh;
+    std::size_t indexCount = 0;
+    bool hasNormals = false;
+    for (const auto& chunk : chunks) {
+        indexCount += chunk.indices.size();
+        hasNormals |= std::any_of(chunk.normalIndices.begin(), chunk.normalIndices.end(),
+            [](std::uint32_t index) { return index != MeshNormals::NONE; });
+    }
+    mesh.x.reserve(vertexCount);
+    mesh.y.reserve(vertexCount);
+    mesh.z.reserve(vertexCount);
+    mesh.indices.reserve(indexCount);
+    if (hasNormals) {
+        mesh.normals.x.reserve(normalCount);
+        mesh.normals.y.reserve(normalCount);
+        mesh.normals.z.reserve(normalCount);
+        mesh.normals.indices.reserve(indexCount);
+    }
+
+    for (auto& chunk : chunks) {
+        append(mesh.x, chunk.x);
+        append(mesh.y, chunk.y);
+        append(mesh.z, chunk.z);
+        append(mesh.indices, chunk.indices);
+        if (hasNormals) {
+            append(mesh.normals.x, chunk.nx);
+            append(mesh.normals.y, chunk.ny);
+            append(mesh.normals.z, chunk.nz);
+            append(mesh.normals.indices, chunk.normalIndices);
+        }
+        mesh.invalidFaces += chunk.invalidFaces;
+        chunk = Chunk();
+    }
+    return mesh;
+}
+
+} // namespace Raytracer
@@ -0,0 +1,51 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** ObjLoader.hpp
+*/
+
+#ifndef RAYTRACER_OBJLOADER_HPP
+#define RAYTRACER_OBJLOADER_HPP
+
+#include "../core/MeshData.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Raytracer {
+
+// Triangulated content of an OBJ file, laid out the way MeshData takes it
+struct ObjMesh {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+    std::vector<std::uint32_t> indices;
+    // Empty when no face references a "vn" normal
+    MeshNormals normals;
+    // Faces with fewer than three corners, and triangles referencing a
+    // missing vertex, left out of the mesh
+    std::size_t invalidFaces = 0;
+};
+
+// Wavefront OBJ reader for "v", "vn" and "f" records; everything else is
+// skipped. The file is mapped in memory and cut at line boundaries into
+// chunks parsed by separate threads in a single pass. Faces with more than
+// three corners are split into a fan around their first corner, and
+// negative indices count back from the last vertex read.
+class ObjLoader {
+public:
+    // threads <= 0 uses one per hardware thread. Throws std::runtime_error
+    // when the file cannot be read or holds too many vertices.
+    static ObjMesh load(const std::string& path, int threads = 0);
+    static ObjMesh parse(const char* data, std::size_t size, int threads = 0);
+
+private:
+    // Smaller files are not worth a thread of their own
+    static constexpr std::size_t MIN_CHUNK_SIZE = 1 << 20;
+};
+
+} // namespace Raytracer
+
+#endif /* RAYTRACER_OBJLOADER_HPP */
@@ -43,6 +43,12 @@ SceneBuilder& SceneBuilder::addLight(std::unique_ptr<ILight> light)
     return *this;
 }
 
+SceneBuilder& SceneBuilder::addSource(const std::string& path)
+{
+    sources.push_back(path);
+    return *this;
+}
+
 Camera& SceneBuilder::setCamera(const Math::Point3D& position)
 {
     camera->setPosition(position.x, position.y, position.z);
@@ -7,6 +7,7 @@
 #include "../interfaces/ILight.hpp"
 #include "../interfaces/IPrimitive.hpp"
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace Raytracer {
@@ -30,21 +31,27 @@ public:
 
     SceneBuilder& addPrimitive(std::unique_ptr<IPrimitive> primitive);
     SceneBuilder& addLight(std::unique_ptr<ILight> light);
+    // Records a file the scene was read from, the scene file first. Caches
+    // of the built scene are keyed by them.
+    SceneBuilder& addSource(const std::string& path);
 
     SceneBuilder& setCamera(std::unique_ptr<Raytracer::Camera> camera);
     SceneBuilder& setScreen(std::unique_ptr<Math::Rectangle3D> screen);
 
     std::vector<std::unique_ptr<IPrimitive>>& getPrimitives();
     std::vector<std::unique_ptr<ILight>>& getLights();
+    const std::vector<std::string>& getSources() const { return sources; }
 
     Camera& setCamera(const Math::Point3D& position);
     Camera& setScreen(int width, int height);
     Camera& getCamera() { return *camera; }
+    const Camera& getCamera() const { return *camera; }
     std::unique_ptr<Scene> build();
 
 private:
     std::vector<std::unique_ptr<IPrimitive>> primitives;
     std::vector<std::unique_ptr<ILight>> lights;
+    std::vector<std::string> sources;
     std::unique_ptr<Raytracer::Camera> camera;
     std::unique_ptr<Math::Rectangle3D> screen;
 };
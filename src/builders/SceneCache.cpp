@@ -0,0 +1,221 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** SceneCache.cpp
+*/
+
+#include "SceneCache.hpp"
+#include "../utils/Debug.hpp"
+#include "../utils/FileStamp.hpp"
+#include "../utils/MappedFile.hpp"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace Raytracer {
+
+namespace {
+
+    constexpr char MAGIC[8] = { 'R', 'T', 'S', 'C', 'E', 'N', 'E', 0 };
+    constexpr std::uint32_t VERSION = 1;
+    constexpr std::uint32_t ENDIAN_PROBE = 0x01020304;
+    constexpr std::size_t ALIGNMENT = 64;
+
+    // The header is followed by one FileStamp per source, then the BVH
+    // nodes and indices, each starting on an ALIGNMENT boundary
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byteOrder;
+        std::uint32_t realSize;
+        std::uint32_t nodeSize;
+        std::uint64_t pathHash; // Hash of the source paths, in order
+        std::uint64_t boxHash; // Hash of the boxes the tree was built over
+        std::uint64_t sourceCount;
+        std::uint64_t itemCount;
+        std::uint64_t nodeCount;
+        std::uint64_t indexCount;
+        double bounds[6]; // BVH bounds, min then max
+    };
+
+    std::size_t align(std::size_t offset)
+    {
+        return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    }
+
+    std::uint64_t hashPaths(const std::vector<std::string>& paths)
+    {
+        std::uint64_t hash = hashBytes(nullptr, 0);
+        for (const std::string& path : paths)
+            hash = hashBytes(path.c_str(), path.size() + 1, hash);
+        return hash;
+    }
+
+    std::uint64_t hashBoxes(const std::vector<AABB>& boxes)
+    {
+        std::uint64_t hash = hashBytes(nullptr, 0);
+        for (const AABB& box : boxes) {
+            const double values[6] = { box.min.x, box.min.y, box.min.z,
+                box.max.x, box.max.y, box.max.z };
+            hash = hashBytes(values, sizeof(values), hash);
+        }
+        return hash;
+    }
+
+    // Offsets of the stamps, nodes and indices, and the end of the file
+    void layout(const Header& header, std::size_t offsets[4])
+    {
+        offsets[0] = align(sizeof(Header));
+        offsets[1] = align(offsets[0] + header.sourceCount * sizeof(FileStamp));
+        offsets[2] = align(offsets[1] + header.nodeCount * sizeof(BVH::Node));
+        offsets[3] = offsets[2] + header.indexCount * sizeof(std::uint32_t);
+    }
+
+    // Writes the tree built over boxes to path as the cache of sources,
+    // stamped with stamps. Errors are logged and otherwise ignored.
+    void writeCache(const std::string& path, const std::vector<std::string>& sources,
+        const std::vector<FileStamp>& stamps, const std::vector<AABB>& boxes, const BVH& bvh)
+    {
+        Header header = {};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.byteOrder = ENDIAN_PROBE;
+        header.realSize = sizeof(Math::Real);
+        header.nodeSize = sizeof(BVH::Node);
+        header.pathHash = hashPaths(sources);
+        header.boxHash = hashBoxes(boxes);
+        header.sourceCount = sources.size();
+        header.itemCount = boxes.size();
+        header.nodeCount = bvh.getNodes().size();
+        header.indexCount = bvh.getIndices().size();
+
+        const AABB& bounds = bvh.getBounds();
+        const double values[6] = { bounds.min.x, bounds.min.y, bounds.min.z,
+            bounds.max.x, bounds.max.y, bounds.max.z };
+        std::memcpy(header.bounds, values, sizeof(values));
+
+        std::size_t offsets[4];
+        layout(header, offsets);
+        const char padding[ALIGNMENT] = {};
+
+        std::error_code error;
+        std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+
+        // Written aside and renamed over the old cache, like mesh caches
+        std::string temporary = path + ".tmp" + std::to_string(getpid());
+        std::ofstream out(temporary, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(padding, offsets[0] - sizeof(header));
+        out.write(reinterpret_cast<const char*>(stamps.data()), stamps.size() * sizeof(FileStamp));
+        out.write(padding, offsets[1] - offsets[0] - stamps.size() * sizeof(FileStamp));
+        out.write(reinterpret_cast<const char*>(bvh.getNodes().data()),
+            bvh.getNodes().size() * sizeof(BVH::Node));
+        out.write(padding, offsets[2] - offsets[1] - bvh.getNodes().size() * sizeof(BVH::Node));
+        out.write(reinterpret_cast<const char*>(bvh.getIndices().data()),
+            bvh.getIndices().size() * sizeof(std::uint32_t));
+        out.close();
+
+        if (!out || std::rename(temporary.c_str(), path.c_str()) != 0) {
+            Debug::log("Failed to write scene cache: ", path);
+            std::remove(temporary.c_str());
+            return;
+        }
+        Debug::log("Wrote scene cache: ", path);
+    }
+
+} // namespace
+
+std::string SceneCache::pathFor(const std::string& scenePath)
+{
+    std::filesystem::path scene(scenePath);
+    return (scene.parent_path() / DIRECTORY / (scene.filename().string() + ".rtscene")).string();
+}
+
+bool SceneCache::load(const std::vector<std::string>& sources,
+    const std::vector<AABB>& boxes, BVH& bvh)
+{
+    if (sources.empty())
+        return false;
+    std::string path = pathFor(sources.front());
+    if (access(path.c_str(), R_OK) != 0)
+        return false;
+
+    try {
+        // Restoring the tree reads every node before the first ray
+        auto file = std::make_shared<const MappedFile>(path, MappedFile::Access::WillNeed);
+        Header header;
+        if (file->size() < sizeof(header))
+            return false;
+        std::memcpy(&header, file->data(), sizeof(header));
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION
+            || header.byteOrder != ENDIAN_PROBE || header.realSize != sizeof(Math::Real)
+            || header.nodeSize != sizeof(BVH::Node) || header.sourceCount != sources.size()
+            || header.pathHash != hashPaths(sources) || header.itemCount != boxes.size()
+            || header.boxHash != hashBoxes(boxes)) {
+            Debug::log("Ignoring stale scene cache: ", path);
+            return false;
+        }
+
+        // Counts are bounded by the file size before computing offsets
+        // from them, so that the sums cannot wrap
+        if (header.nodeCount > file->size() / sizeof(BVH::Node)
+            || header.indexCount > file->size() / sizeof(std::uint32_t)) {
+            throw std::invalid_argument("Truncated scene cache");
+        }
+        std::size_t offsets[4];
+        layout(header, offsets);
+        if (offsets[3] > file->size())
+            throw std::invalid_argument("Truncated scene cache");
+
+        std::vector<FileStamp> stamps(sources.size());
+        std::memcpy(stamps.data(), file->data() + offsets[0], stamps.size() * sizeof(FileStamp));
+        bool refreshed = false;
+        for (std::size_t i = 0; i < sources.size(); i++) {
+            std::int64_t recordedTime = stamps[i].time;
+            if (!stamps[i].matches(sources[i])) {
+                Debug::log("Ignoring stale scene cache: ", path);
+                return false;
+            }
+            refreshed |= stamps[i].time != recordedTime;
+        }
+        bvh.restore(Buffer<BVH::Node>(reinterpret_cast<const BVH::Node*>(file->data() + offsets[1]),
+                        header.nodeCount, file),
+            Buffer<std::uint32_t>(reinterpret_cast<const std::uint32_t*>(file->data() + offsets[2]),
+                header.indexCount, file),
+            AABB(Math::Point3D(header.bounds[0], header.bounds[1], header.bounds[2]),
+                Math::Point3D(header.bounds[3], header.bounds[4], header.bounds[5])),
+            boxes.size());
+        // Record the new times through a fresh file, the restored tree
+        // keeps reading the old one
+        if (refreshed)
+            writeCache(path, sources, stamps, boxes, bvh);
+        return true;
+    } catch (const std::exception& e) {
+        Debug::log("Ignoring invalid scene cache ", path, ": ", e.what());
+        return false;
+    }
+}
+
+void SceneCache::save(const std::vector<std::string>& sources,
+    const std::vector<AABB>& boxes, const BVH& bvh)
+{
+    if (sources.empty())
+        return;
+
+    std::vector<FileStamp> stamps;
+    try {
+        for (const std::string& source : sources)
+            stamps.push_back(FileStamp::of(source));
+    } catch (const std::exception& e) {
+        Debug::log("Not caching scene ", sources.front(), ": ", e.what());
+        return;
+    }
+    writeCache(pathFor(sources.front()), sources, stamps, boxes, bvh);
+}
+
+} // namespace Raytracer
@@ -0,0 +1,50 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** SceneCache.hpp
+*/
+
+#ifndef RAYTRACER_SCENECACHE_HPP
+#define RAYTRACER_SCENECACHE_HPP
+
+#include "../core/AABB.hpp"
+#include "../core/BVH.hpp"
+#include <string>
+#include <vector>
+
+namespace Raytracer {
+
+// Top-level BVH of a scene, kept in a DIRECTORY folder next to the scene
+// file as "<scene>.rtscene" so that rendering the same scene again with
+// other camera or sampling settings maps the tree instead of building it.
+// The folder keeps caches out of scene listings.
+// Meshes keep their own trees in their MeshCache files.
+// A cache is keyed by the files the scene was read from, the scene file
+// first and then the OBJ files it references, with the same size, time
+// and hash check as MeshCache. It also records a hash of the primitive
+// boxes the tree was built over, so a tree from a build of the program
+// that bounds primitives differently is never reused.
+class SceneCache {
+public:
+    // Scenes with fewer bounded primitives build their tree faster than
+    // a cache is checked, they are not cached
+    static constexpr std::size_t MIN_PRIMITIVES = 4096;
+    static constexpr const char* DIRECTORY = ".rtcache";
+
+    static std::string pathFor(const std::string& scenePath);
+
+    // Restores into bvh the tree cached for sources over boxes. Returns
+    // false when there is no valid cache.
+    static bool load(const std::vector<std::string>& sources,
+        const std::vector<AABB>& boxes, BVH& bvh);
+
+    // Writes the cache of sources. Errors are logged and otherwise
+    // ignored, the cache only saves time.
+    static void save(const std::vector<std::string>& sources,
+        const std::vector<AABB>& boxes, const BVH& bvh);
+};
+
+} // namespace Raytracer
+
+#endif /* RAYTRACER_SCENECACHE_HPP */
@@ -16,6 +16,8 @@
  * ------------------------------------------------------------------------------------ */
 
 #include "SceneLoader.hpp"
+#include "MeshCache.hpp"
+#include "ObjLoader.hpp"
 #include "../core/AmbiantLight.hpp"
 #include "../core/Cone.hpp"
 #include "../core/Cube.hpp"
@@ -26,13 +28,12 @@
 #include "../core/Scene.hpp"
 #include "../core/Sphere.hpp"
 #include "../core/Triangle.hpp"
+#include "../core/TriangleMesh.hpp"
 #include "../factories/LightFactory.hpp"
 #include "../factories/MaterialFactory.hpp"
 #include "../factories/PrimitiveFactory.hpp"
 #include "../utils/Debug.hpp"
-#include <array>
-#include <fstream>
-#include <sstream>
+#include <cmath>
 #include <stdexcept>
 
 namespace Raytracer {
@@ -67,6 +68,7 @@ std::unique_ptr<Scene> SceneLoader::loadSceneFromFile(const std::string& filenam
     } catch (const libconfig::ParseException& e) {
         throw std::runtime_error("Error parsing config file: " + filename);
     }
+    builder.addSource(filename);
 
     const libconfig::Setting& root = cfg.getRoot();
 
@@ -92,13 +94,23 @@ void SceneLoader::loadObjects(const libconfig::Setting& objects)
         if (!obj.lookupValue("file", filepath))
             throw std::runtime_error("Missing file path in object configuration");
 
-        Math::Point3D position(0, 0, 0);
+        Math::Vector3D position(0, 0, 0);
         if (obj.exists("position")) {
             double x = 0, y = 0, z = 0;
             obj["position"].lookupValue("x", x);
             obj["position"].lookupValue("y", y);
             obj["position"].lookupValue("z", z);
-            position = Math::Point3D(x, y, z);
+            position = Math::Vector3D(x, y, z);
+        }
+
+        // In degrees, like the rotation of primitive transforms
+        Math::Vector3D rotation(0, 0, 0);
+        if (obj.exists("rotation")) {
+            double x = 0, y = 0, z = 0;
+            obj["rotation"].lookupValue("x", x);
+            obj["rotation"].lookupValue("y", y);
+            obj["rotation"].lookupValue("z", z);
+            rotation = Math::Vector3D(x * M_PI / 180.0, y * M_PI / 180.0, z * M_PI / 180.0);
         }
 
         const libconfig::Setting* materialSettings = nullptr;
@@ -106,50 +118,57 @@ void SceneLoader::loadObjects(const libconfig::Setting& objects)
             materialSettings = &obj["material"];
         }
 
-        loadObjFile(filepath, position, materialSettings);
+        loadObjFile(filepath, Transform(rotation, position), materialSettings);
     }
 }
 
 void SceneLoader::loadObjFile(const std::string& filepath,
-    const Math::Point3D& position,
+    const Transform& transform,
     const libconfig::Setting* materialSettings)
 {
-    Debug::log("Loading OBJ file: ", filepath);
-    std::ifstream file(filepath);
-    if (!file.is_open()) {
-        throw std::runtime_error("Failed to open OBJ file: " + filepath);
+    std::shared_ptr<const MeshData> mesh = loadMesh(filepath);
+    if (!mesh)
+        return;
+
+    std::unique_ptr<IMaterial> material = nullptr;
+    if (materialSettings) {
+        std::string materialType = "matte";
+        materialSettings->lookupValue("type", materialType);
+        material = MaterialFactory::createMaterial(materialType, *materialSettings);
     }
+    builder.addPrimitive(std::make_unique<TriangleMesh>(std::move(mesh),
+        std::move(material), transform));
+}
 
-    auto vertices = parseVertices(file);
-    file.clear();
-    file.seekg(0);
-    auto faces = parseFaces(file);
+std::shared_ptr<const MeshData> SceneLoader::loadMesh(const std::string& filepath)
+{
+    auto found = meshes.find(filepath);
+    if (found != meshes.end())
+        return found->second;
 
-    for (const auto& face : faces) {
-        if (face[0] >= vertices.size() || face[1] >= vertices.size() || face[2] >= vertices.size()) {
-            Debug::log("Invalid face indices in OBJ file");
-            continue;
+    Debug::log("Loading OBJ file: ", filepath);
+    builder.addSource(filepath);
+    std::shared_ptr<const MeshData> mesh = MeshCache::load(filepath);
+    if (mesh) {
+        Debug::log("Loaded mesh from cache: ", MeshCache::pathFor(filepath));
+    } else {
+        ObjMesh obj = ObjLoader::load(filepath);
+        if (obj.invalidFaces > 0)
+            Debug::log("Skipped ", obj.invalidFaces, " invalid faces in OBJ file");
+        if (obj.indices.empty()) {
+            Debug::log("No valid faces in OBJ file: ", filepath);
+            meshes[filepath] = nullptr;
+            return nullptr;
         }
 
-        Math::Point3D v1(vertices[face[0]].x + position.x,
-            vertices[face[0]].y + position.y,
-            vertices[face[0]].z + position.z);
-        Math::Point3D v2(vertices[face[1]].x + position.x,
-            vertices[face[1]].y + position.y,
-            vertices[face[1]].z + position.z);
-        Math::Point3D v3(vertices[face[2]].x + position.x,
-            vertices[face[2]].y + position.y,
-            vertices[face[2]].z + position.z);
-
-        std::unique_ptr<IMaterial> material = nullptr;
-        if (materialSettings) {
-            std::string materialType = "matte";
-            materialSettings->lookupValue("type", materialType);
-            material = MaterialFactory::createMaterial(materialType, *materialSettings);
-        }
-        auto triangle = std::make_unique<Triangle>(v1, v2, v3, std::move(material));
-        builder.addPrimitive(std::move(triangle));
+        mesh = std::make_shared<const MeshData>(std::move(obj.x), std::move(obj.y),
+            std::move(obj.z), std::move(obj.indices), std::move(obj.normals));
+        MeshCache::save(filepath, *mesh);
     }
+    Debug::log("Loaded mesh with ", mesh->getTriangleCount(), " triangles and ",
+        mesh->getVertexCount(), " vertices (", mesh->memoryUsage(), " bytes)");
+    meshes[filepath] = mesh;
+    return mesh;
 }
 
 void SceneLoader::loadPrimitives(const libconfig::Setting& primitives)
@@ -169,71 +188,6 @@ void SceneLoader::loadPrimitives(const libconfig::Setting& primitives)
     }
 }
 
-std::vector<Math::Point3D> SceneLoader::parseVertices(std::ifstream& file)
-{
-    std::vector<Math::Point3D> vertices;
-    std::string line;
-
-    while (std::getline(file, line)) {
-        if (line.empty() || line[0] == '#')
-            continue;
-
-        std::istringstream iss(line);
-        char type;
-        iss >> type;
-
-        if (type == 'v') {
-            double x, y, z;
-            if (iss >> x >> y >> z) {
-                vertices.emplace_back(x, y, z);
-            }
-        }
-    }
-    return vertices;
-}
-
-std::vector<std::array<size_t, 3>> SceneLoader::parseFaces(std::ifstream& file)
-{
-    std::vector<std::array<size_t, 3>> faces;
-    std::string line;
-
-    while (std::getline(file, line)) {
-        if (line.empty() || line[0] == '#')
-            continue;
-
-        std::istringstream iss(line);
-        char type;
-        iss >> type;
-
-        if (type == 'f') {
-            std::string v1_full, v2_full, v3_full, v4_full;
-            if (!(iss >> v1_full >> v2_full >> v3_full)) {
-                continue;
-            }
-            bool isQuad = false;
-            if (iss >> v4_full) {
-                isQuad = true;
-            }
-
-            auto getVertexIndex = [](const std::string& vertex_str) -> size_t {
-                return std::stoul(vertex_str.substr(0, vertex_str.find('/'))) - 1;
-            };
-
-            size_t v1 = getVertexIndex(v1_full);
-            size_t v2 = getVertexIndex(v2_full);
-            size_t v3 = getVertexIndex(v3_full);
-
-            faces.push_back({ v1, v2, v3 });
-
-            if (isQuad) {
-                size_t v4 = getVertexIndex(v4_full);
-                faces.push_back({ v1, v3, v4 });
-            }
-        }
-    }
-    return faces;
-}
-
 void SceneLoader::loadLights(const libconfig::Setting& lights)
 {
     for (const auto& type : LightFactory::getRegisteredTypes()) {
@@ -2,9 +2,12 @@
 #define RAYTRACER_SCENELOADER_HPP_
 
 #include "SceneBuilder.hpp"
+#include "../core/MeshData.hpp"
+#include "../core/Transform.hpp"
 #include <libconfig.h++>
 #include <memory>
 #include <string>
+#include <unordered_map>
 
 namespace Raytracer {
 
@@ -25,11 +28,14 @@ private:
 
 private:
     void loadObjFile(const std::string& filepath,
-        const Math::Point3D& position,
+        const Transform& transform,
         const libconfig::Setting* materialSettings = nullptr);
-    std::vector<Math::Point3D> parseVertices(std::ifstream& file);
-    std::vector<std::array<size_t, 3>> parseFaces(std::ifstream& file);
+    // Mesh of an OBJ file, loaded once and shared by all its placements.
+    // nullptr when the file has no valid face.
+    std::shared_ptr<const MeshData> loadMesh(const std::string& filepath);
+
     SceneBuilder& builder;
+    std::unordered_map<std::string, std::shared_ptr<const MeshData>> meshes;
 };
 
 }
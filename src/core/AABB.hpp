@@ -0,0 +1,137 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** AABB.hpp
+*/
+
+#ifndef RAYTRACER_AABB_HPP
+#define RAYTRACER_AABB_HPP
+
+#include "Point3D.hpp"
+#include "Ray.hpp"
+#include "Vector3D.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Raytracer {
+
+// Bounding Box Structure
+struct AABB {
+    Math::Point3D min; // Minimum coordinates
+    Math::Point3D max; // Maximum coordinates
+
+    // Default box is empty, so that expanding it by anything yields that thing
+    AABB()
+        : min(std::numeric_limits<Math::Real>::infinity(),
+              std::numeric_limits<Math::Real>::infinity(),
+              std::numeric_limits<Math::Real>::infinity())
+        , max(-std::numeric_limits<Math::Real>::infinity(),
+              -std::numeric_limits<Math::Real>::infinity(),
+              -std::numeric_limits<Math::Real>::infinity())
+    {
+    }
+
+    AABB(const Math::Point3D& min, const Math::Point3D& max)
+        : min(min)
+        , max(max)
+    {
+    }
+
+    // Box covering all of space, returned by unbounded primitives (planes...)
+    static AABB infinite()
+    {
+        Math::Real inf = std::numeric_limits<Math::Real>::infinity();
+        return AABB(Math::Point3D(-inf, -inf, -inf), Math::Point3D(inf, inf, inf));
+    }
+
+    bool isEmpty() const
+    {
+        return min.x > max.x || min.y > max.y || min.z > max.z;
+    }
+
+    bool isFinite() const
+    {
+        return !isEmpty() && std::isfinite(min.x) && std::isfinite(min.y)
+            && std::isfinite(min.z) && std::isfinite(max.x)
+            && std::isfinite(max.y) && std::isfinite(max.z);
+    }
+
+    void expand(const Math::Point3D& point)
+    {
+        min = Math::Point3D(std::min(min.x, point.x), std::min(min.y, point.y),
+            std::min(min.z, point.z));
+        max = Math::Point3D(std::max(max.x, point.x), std::max(max.y, point.y),
+            std::max(max.z, point.z));
+    }
+
+    void expand(const AABB& box)
+    {
+        expand(box.min);
+        expand(box.max);
+    }
+
+    Math::Point3D centroid() const
+    {
+        return Math::Point3D((min.x + max.x) * 0.5, (min.y + max.y) * 0.5,
+            (min.z + max.z) * 0.5);
+    }
+
+    double surfaceArea() const
+    {
+        if (isEmpty())
+            return 0.0;
+        Math::Vector3D d = max - min;
+        return 2.0 * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+
+    int longestAxis() const
+    {
+        Math::Vector3D d = max - min;
+        if (d.x >= d.y && d.x >= d.z)
+            return 0;
+        return d.y >= d.z ? 1 : 2;
+    }
+
+    // Whether the ray meets the box in front of its origin
+    bool intersect(const Ray& ray) const
+    {
+        Math::Vector3D invDir(1 / ray.direction.x, 1 / ray.direction.y,
+            1 / ray.direction.z);
+        Math::Real tEntry;
+        return intersect(ray.origin, invDir, 0,
+            std::numeric_limits<Math::Real>::infinity(), tEntry);
+    }
+
+    // Slab test clipped to [tMin, tMax], with the inverse direction computed
+    // once per ray by the caller. NaNs (origin on a slab, parallel ray) fall
+    // through std::min/std::max and leave the interval untouched.
+    bool intersect(const Math::Point3D& origin, const Math::Vector3D& invDir,
+        Math::Real tMin, Math::Real tMax, Math::Real& tEntry) const
+    {
+        Math::Real t0 = (min.x - origin.x) * invDir.x;
+        Math::Real t1 = (max.x - origin.x) * invDir.x;
+        tMin = std::max(tMin, std::min(t0, t1));
+        tMax = std::min(tMax, std::max(t0, t1));
+
+        t0 = (min.y - origin.y) * invDir.y;
+        t1 = (max.y - origin.y) * invDir.y;
+        tMin = std::max(tMin, std::min(t0, t1));
+        tMax = std::min(tMax, std::max(t0, t1));
+
+        t0 = (min.z - origin.z) * invDir.z;
+        t1 = (max.z - origin.z) * invDir.z;
+        tMin = std::max(tMin, std::min(t0, t1));
+        tMax = std::min(tMax, std::max(t0, t1));
+
+        // Widen the exit slightly so rounding never opens cracks between
+        // flat boxes (PBRT's 1 + 2 * gamma(3) bound)
+        tEntry = tMin;
+        return tMin <= tMax * (1 + 4 * std::numeric_limits<Math::Real>::epsilon());
+    }
+};
+
+} // namespace Raytracer
+
+#endif /* RAYTRACER_AABB_HPP */
@@ -0,0 +1,294 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** BVH.cpp
+*/
+
+#include "BVH.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace Raytracer {
+
+namespace {
+
+    constexpr int SAH_BINS = 16;
+    constexpr double TRAVERSAL_COST = 1.0;
+    constexpr double INTERSECTION_COST = 1.0;
+
+    double pointComponent(const Math::Point3D& p, int axis)
+    {
+        return axis == 0 ? p.x : (axis == 1 ? p.y : p.z);
+    }
+
+} // namespace
+
+void BVH::build(const std::vector<AABB>& boxes, std::size_t maxLeafSize,
+    std::size_t leafAlignment)
+{
+    _nodes = Buffer<Node>();
+    _indices = Buffer<std::uint32_t>();
+    _bounds = AABB();
+
+    if (boxes.empty())
+        return;
+
+    std::vector<BuildItem> items;
+    items.reserve(boxes.size());
+    for (std::size_t i = 0; i < boxes.size(); i++) {
+        items.push_back({ boxes[i], boxes[i].centroid(), static_cast<std::uint32_t>(i) });
+    }
+
+    std::vector<BuildNode> binary;
+    std::vector<std::uint32_t> indices;
+    binary.reserve(2 * boxes.size());
+    indices.reserve(boxes.size());
+    buildRecursive(binary, indices, items, 0, items.size(),
+        std::max<std::size_t>(1, maxLeafSize),
+        std::max<std::size_t>(1, leafAlignment), 0);
+    while (indices.size() % std::max<std::size_t>(1, leafAlignment) != 0)
+        indices.push_back(EMPTY);
+
+    std::vector<Node> nodes;
+    nodes.reserve(binary.size() / 2 + 1);
+    collapse(binary, 0, nodes);
+
+    // Each wide node replaces up to WIDTH - 1 binary ones
+    nodes.shrink_to_fit();
+    _nodes = std::move(nodes);
+    _indices = std::move(indices);
+    _bounds = binary.front().bounds;
+}
+
+void BVH::restore(Buffer<Node> nodes, Buffer<std::uint32_t> indices,
+    const AABB& bounds, std::size_t itemCount)
+{
+    // EMPTY only pads between leaves, the entries of a leaf are checked
+    // below
+    for (std::uint32_t index : indices) {
+        if (index != EMPTY && index >= itemCount)
+            throw std::invalid_argument("BVH leaf references a missing item");
+    }
+
+    // Nodes come after their parent and are referenced once, which rules
+    // out cycles, and the depth must fit the traversal stacks
+    std::vector<std::size_t> depth(nodes.size(), 0);
+    std::vector<bool> referenced(nodes.size(), false);
+    for (std::size_t i = 0; i < nodes.size(); i++) {
+        if (i > 0 && !referenced[i])
+            throw std::invalid_argument("BVH node is not referenced");
+        for (int c = 0; c < WIDTH; c++) {
+            std::uint32_t child = nodes[i].child[c];
+            std::uint16_t count = nodes[i].count[c];
+            if (child == EMPTY)
+                continue;
+            if (count > 0) {
+                if (child > indices.size() || count > indices.size() - child)
+                    throw std::invalid_argument("BVH leaf is out of range");
+                for (std::size_t j = child; j < child + count; j++) {
+                    if (indices[j] == EMPTY)
+                        throw std::invalid_argument("BVH leaf references a missing item");
+                }
+                continue;
+            }
+            if (child <= i || child >= nodes.size() || referenced[child])
+                throw std::invalid_argument("BVH node has an invalid child");
+            referenced[child] = true;
+            depth[child] = depth[i] + 1;
+            // MAX_DEPTH levels of interior nodes, the root being level 0
+            if (depth[child] >= MAX_DEPTH)
+                throw std::invalid_argument("BVH is too deep");
+        }
+    }
+
+    _nodes = std::move(nodes);
+    _indices = std::move(indices);
+    _bounds = bounds;
+}
+
+std::uint32_t BVH::buildRecursive(std::vector<BuildNode>& nodes,
+    std::vector<std::uint32_t>& indices, std::vector<BuildItem>& items, std::size_t begin, std::size_t end,
+    std::size_t maxLeafSize, std::size_t leafAlignment, std::size_t depth)
+{
+    std::uint32_t nodeIndex = static_cast<std::uint32_t>(nodes.size());
+    nodes.push_back(BuildNode());
+
+    AABB bounds;
+    AABB centroidBounds;
+    for (std::size_t i = begin; i < end; i++) {
+        bounds.expand(items[i].bounds);
+        centroidBounds.expand(items[i].centroid);
+    }
+
+    std::size_t count = end - begin;
+
+    auto makeLeaf = [&]() {
+        if (count > std::numeric_limits<std::uint16_t>::max())
+            throw std::runtime_error("BVH leaf too large, scene is degenerate");
+        while (indices.size() % leafAlignment != 0)
+            indices.push_back(EMPTY);
+        BuildNode& node = nodes[nodeIndex];
+        node.bounds = bounds;
+        node.offset = static_cast<std::uint32_t>(indices.size());
+        node.count = static_cast<std::uint16_t>(count);
+        for (std::size_t i = begin; i < end; i++)
+            indices.push_back(items[i].index);
+        return nodeIndex;
+    };
+
+    if (count <= maxLeafSize || depth + 2 >= MAX_DEPTH)
+        return makeLeaf();
+
+    // Binned SAH: project centroids into buckets along each axis and sweep
+    // the bucket boundaries for the cheapest split
+    int bestAxis = -1;
+    int bestSplit = 0;
+    double bestCost = std::numeric_limits<double>::infinity();
+
+    for (int axis = 0; axis < 3; axis++) {
+        double cmin = pointComponent(centroidBounds.min, axis);
+        double cmax = pointComponent(centroidBounds.max, axis);
+        if (cmax - cmin <= 0.0)
+            continue;
+
+        AABB binBounds[SAH_BINS];
+        std::size_t binCounts[SAH_BINS] = {};
+        double scale = SAH_BINS / (cmax - cmin);
+
+        for (std::size_t i = begin; i < end; i++) {
+            int bin = static_cast<int>((pointComponent(items[i].centroid, axis) - cmin) * scale);
+            bin = std::min(bin, SAH_BINS - 1);
+            binCounts[bin]++;
+            binBounds[bin].expand(items[i].bounds);
+        }
+
+        // Right-to-left sweep gives the area and count of every right side
+        double rightArea[SAH_BINS];
+        std::size_t rightCount[SAH_BINS];
+        AABB acc;
+        std::size_t accCount = 0;
+        for (int b = SAH_BINS - 1; b > 0; b--) {
+            acc.expand(binBounds[b]);
+            accCount += binCounts[b];
+            rightArea[b] = acc.surfaceArea();
+            rightCount[b] = accCount;
+        }
+
+        acc = AABB();
+        accCount = 0;
+        for (int b = 0; b < SAH_BINS - 1; b++) {
+            acc.expand(binBounds[b]);
+            accCount += binCounts[b];
+            if (accCount == 0 || rightCount[b + 1] == 0)
+                continue;
+            double cost = acc.surfaceArea() * accCount + rightArea[b + 1] * rightCount[b + 1];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestAxis = axis;
+                bestSplit = b;
+            }
+        }
+    }
+
+    std::size_t mid;
+    double parentArea = bounds.surfaceArea();
+
+    if (bestAxis < 0) {
+        // All centroids coincide: any partition is as good as another
+        mid = begin + count / 2;
+    } else {
+        double leafCost = INTERSECTION_COST * count;
+        double splitCost = parentArea > 0.0
+            ? TRAVERSAL_COST + INTERSECTION_COST * bestCost / parentArea
+            : leafCost;
+        if (splitCost >= leafCost && count <= 4 * maxLeafSize)
+            return makeLeaf();
+
+        double cmin = pointComponent(centroidBounds.min, bestAxis);
+        double scale = SAH_BINS / (pointComponent(centroidBounds.max, bestAxis) - cmin);
+        auto pivot = std::partition(items.begin() + begin, items.begin() + end,
+            [&](const BuildItem& item) {
+                int bin = static_cast<int>((pointComponent(item.centroid, bestAxis) - cmin) * scale);
+                return std::min(bin, SAH_BINS - 1) <= bestSplit;
+            });
+        mid = static_cast<std::size_t>(pivot - items.begin());
+        if (mid == begin || mid == end)
+            mid = begin + count / 2;
+    }
+
+    buildRecursive(nodes, indices, items, begin, mid, maxLeafSize, leafAlignment,
+        depth + 1);
+    std::uint32_t right = buildRecursive(nodes, indices, items, mid, end,
+        maxLeafSize, leafAlignment, depth + 1);
+
+    BuildNode& node = nodes[nodeIndex];
+    node.bounds = bounds;
+    node.offset = right;
+    node.count = 0;
+    return nodeIndex;
+}
+
+std::uint32_t BVH::collapse(const std::vector<BuildNode>& nodes,
+    std::uint32_t index, std::vector<Node>& wide)
+{
+    // Open the largest interior child until the node is full, which pulls
+    // up the grandchildren a ray is most likely to reach
+    std::uint32_t slots[WIDTH];
+    int used = 0;
+
+    if (nodes[index].count > 0) {
+        slots[used++] = index;
+    } else {
+        slots[used++] = index + 1;
+        slots[used++] = nodes[index].offset;
+    }
+    while (used < WIDTH) {
+        int largest = -1;
+        double largestArea = -1.0;
+        for (int i = 0; i < used; i++) {
+            const BuildNode& slot = nodes[slots[i]];
+            if (slot.count == 0 && slot.bounds.surfaceArea() > largestArea) {
+                largest = i;
+                largestArea = slot.bounds.surfaceArea();
+            }
+        }
+        if (largest < 0)
+            break;
+        std::uint32_t opened = slots[largest];
+        slots[largest] = opened + 1;
+        slots[used++] = nodes[opened].offset;
+    }
+
+    std::uint32_t nodeIndex = static_cast<std::uint32_t>(wide.size());
+    wide.push_back(Node());
+
+    Math::Real inf = std::numeric_limits<Math::Real>::infinity();
+    for (int i = 0; i < WIDTH; i++) {
+        std::uint32_t child = EMPTY;
+        std::uint16_t count = 0;
+        AABB box(Math::Point3D(inf, inf, inf), Math::Point3D(inf, inf, inf));
+
+        if (i < used) {
+            const BuildNode& slot = nodes[slots[i]];
+            box = slot.bounds;
+            count = slot.count;
+            child = count > 0 ? slot.offset : collapse(nodes, slots[i], wide);
+        }
+
+        // collapse() grows wide, so the node is looked up again
+        Node& node = wide[nodeIndex];
+        node.minX[i] = box.min.x;
+        node.minY[i] = box.min.y;
+        node.minZ[i] = box.min.z;
+        node.maxX[i] = box.max.x;
+        node.maxY[i] = box.max.y;
+        node.maxZ[i] = box.max.z;
+        node.child[i] = child;
+        node.count[i] = count;
+    }
+    return nodeIndex;
+}
+
+} // namespace Raytracer
@@ -0,0 +1,343 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** BVH.hpp
+*/
+
+#ifndef RAYTRACER_BVH_HPP
+#define RAYTRACER_BVH_HPP
+
+#include "AABB.hpp"
+#include "Buffer.hpp"
+#include "Ray.hpp"
+#include "RayPacket.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Raytracer {
+
+// Bounding volume hierarchy built with the surface area heuristic.
+// It only knows about boxes: callers hand it one AABB per item and get back
+// item indices in leaves, so the same tree serves scene primitives and mesh
+// triangles alike.
+// The binary tree the SAH builds is collapsed into WIDTH-wide nodes whose
+// child boxes are stored axis by axis, so one loop tests a ray against all
+// the children of a node and the compiler can keep the lanes in vector
+// registers. Leaves are stored in their parent's child slots.
+class BVH {
+public:
+    static constexpr int WIDTH = 4;
+
+    struct Node {
+        alignas(32) Math::Real minX[WIDTH];
+        alignas(32) Math::Real minY[WIDTH];
+        alignas(32) Math::Real minZ[WIDTH];
+        alignas(32) Math::Real maxX[WIDTH];
+        alignas(32) Math::Real maxY[WIDTH];
+        alignas(32) Math::Real maxZ[WIDTH];
+        // Leaf: first entry in indices. Interior: child node. EMPTY when
+        // the slot is unused.
+        std::uint32_t child[WIDTH];
+        std::uint16_t count[WIDTH]; // Number of items in a leaf, 0 otherwise
+    };
+
+    static constexpr std::uint32_t EMPTY = 0xffffffff;
+    static constexpr std::size_t MAX_DEPTH = 64;
+    // Every node visited pushes at most WIDTH - 1 more entries than it pops
+    static constexpr std::size_t STACK_SIZE = MAX_DEPTH * (WIDTH - 1) + 1;
+
+    BVH() = default;
+
+    // leafAlignment pads indices so that every leaf starts on a multiple of
+    // it and their total size is a multiple of it, the padding entries
+    // holding EMPTY. Callers storing item data in leaf order use it to lay
+    // leaves out in fixed-size blocks.
+    void build(const std::vector<AABB>& boxes, std::size_t maxLeafSize = 4,
+        std::size_t leafAlignment = 1);
+
+    // Takes over a tree saved from getNodes(), getIndices() and
+    // getBounds() of an earlier build over itemCount boxes. Throws
+    // std::invalid_argument when the buffers do not form such a tree.
+    void restore(Buffer<Node> nodes, Buffer<std::uint32_t> indices,
+        const AABB& bounds, std::size_t itemCount);
+
+    bool empty() const { return _nodes.empty(); }
+    const AABB& getBounds() const { return _bounds; }
+    const Buffer<Node>& getNodes() const { return _nodes; }
+    const Buffer<std::uint32_t>& getIndices() const { return _indices; }
+
+    // Closest-hit traversal, children visited nearest first. leaf(index,
+    // tMax) tests one item, shrinks tMax and returns true when it found a
+    // closer hit.
+    template <typename LeafFunc>
+    bool intersect(const Ray& ray, double& tMax, LeafFunc&& leaf) const;
+
+    // intersect() one leaf at a time: leaf(first, count, tMax) tests the
+    // items at indices[first] to indices[first + count - 1]
+    template <typename LeafFunc>
+    bool intersectLeaves(const Ray& ray, double& tMax, LeafFunc&& leaf) const;
+
+    // Closest-hit traversal of a whole packet, tMax holds one bound per
+    // lane. A child is entered when any lane hits its box and leaf(index,
+    // tMax) tests every lane, shrinking the bounds of the lanes it hits.
+    template <typename LeafFunc>
+    void intersectPacket(const RayPacket& packet, double* tMax,
+        LeafFunc&& leaf) const;
+
+    // Any-hit traversal for shadow rays: stops at the first item for which
+    // leaf(index, tMax) reports a hit closer than tMax.
+    template <typename LeafFunc>
+    bool occluded(const Ray& ray, double tMax, LeafFunc&& leaf) const;
+
+private:
+    struct BuildItem {
+        AABB bounds;
+        Math::Point3D centroid;
+        std::uint32_t index;
+    };
+
+    // Binary node produced by the SAH build, before collapsing
+    struct BuildNode {
+        AABB bounds;
+        std::uint32_t offset; // Leaf: first entry in indices. Interior: right child
+        std::uint16_t count; // Number of items in a leaf, 0 for interior nodes
+    };
+
+    // Child slot on the traversal stack, with the distance at which the
+    // ray enters its box
+    struct StackEntry {
+        std::uint32_t child;
+        std::uint16_t count;
+        Math::Real tEntry;
+    };
+
+    std::uint32_t buildRecursive(std::vector<BuildNode>& nodes,
+        std::vector<std::uint32_t>& indices, std::vector<BuildItem>& items,
+        std::size_t begin, std::size_t end, std::size_t maxLeafSize,
+        std::size_t leafAlignment, std::size_t depth);
+    std::uint32_t collapse(const std::vector<BuildNode>& nodes,
+        std::uint32_t index, std::vector<Node>& wide);
+
+    // Bit i set when the ray enters child i of the node before tMax
+    static unsigned intersectChildren(const Node& node,
+        const Math::Point3D& origin, const Math::Vector3D& invDir,
+        Math::Real tMax, Math::Real* tEntry);
+
+    Buffer<Node> _nodes;
+    Buffer<std::uint32_t> _indices;
+    AABB _bounds;
+};
+
+inline Math::Vector3D inverseDirection(const Math::Vector3D& direction)
+{
+    return Math::Vector3D(1.0 / direction.x, 1.0 / direction.y, 1.0 / direction.z);
+}
+
+inline unsigned BVH::intersectChildren(const Node& node,
+    const Math::Point3D& origin, const Math::Vector3D& invDir,
+    Math::Real tMax, Math::Real* tEntry)
+{
+    // Same slab test as AABB::intersect, one lane per child. Empty slots
+    // hold a box at +infinity that every ray misses. The intervals go to
+    // local arrays first: writing tEntry from this loop would keep the
+    // compiler from vectorizing it.
+    const Math::Real widen = 1 + 4 * std::numeric_limits<Math::Real>::epsilon();
+    alignas(32) Math::Real nearT[WIDTH];
+    alignas(32) Math::Real farT[WIDTH];
+    const Math::Real ox = origin.x, oy = origin.y, oz = origin.z;
+    const Math::Real ix = invDir.x, iy = invDir.y, iz = invDir.z;
+
+    for (int i = 0; i < WIDTH; i++) {
+        Math::Real t0 = (node.minX[i] - ox) * ix;
+        Math::Real t1 = (node.maxX[i] - ox) * ix;
+        Math::Real near = std::max<Math::Real>(0, std::min(t0, t1));
+        Math::Real far = std::min(tMax, std::max(t0, t1));
+
+        t0 = (node.minY[i] - oy) * iy;
+        t1 = (node.maxY[i] - oy) * iy;
+        near = std::max(near, std::min(t0, t1));
+        far = std::min(far, std::max(t0, t1));
+
+        t0 = (node.minZ[i] - oz) * iz;
+        t1 = (node.maxZ[i] - oz) * iz;
+        nearT[i] = std::max(near, std::min(t0, t1));
+        farT[i] = std::min(far, std::max(t0, t1));
+    }
+
+    unsigned mask = 0;
+    for (int i = 0; i < WIDTH; i++) {
+        tEntry[i] = nearT[i];
+        mask |= static_cast<unsigned>(nearT[i] <= farT[i] * widen) << i;
+    }
+    return mask;
+}
+
+template <typename LeafFunc>
+bool BVH::intersect(const Ray& ray, double& tMax, LeafFunc&& leaf) const
+{
+    return intersectLeaves(ray, tMax,
+        [&](std::uint32_t first, std::uint32_t count, double& leafMax) {
+            bool hit = false;
+            for (std::uint32_t i = 0; i < count; i++) {
+                if (leaf(_indices[first + i], leafMax))
+                    hit = true;
+            }
+            return hit;
+        });
+}
+
+template <typename LeafFunc>
+bool BVH::intersectLeaves(const Ray& ray, double& tMax, LeafFunc&& leaf) const
+{
+    if (_nodes.empty())
+        return false;
+
+    Math::Vector3D invDir = inverseDirection(ray.direction);
+    StackEntry stack[STACK_SIZE];
+    std::size_t stackSize = 0;
+    bool hit = false;
+    alignas(32) Math::Real tEntry[WIDTH];
+
+    stack[stackSize++] = { 0, 0, 0 };
+    while (stackSize > 0) {
+        StackEntry entry = stack[--stackSize];
+
+        // A closer hit was found since the box was pushed
+        if (entry.tEntry > tMax)
+            continue;
+
+        if (entry.count > 0) {
+            if (leaf(entry.child, entry.count, tMax))
+                hit = true;
+            continue;
+        }
+
+        const Node& node = _nodes[entry.child];
+        unsigned mask = intersectChildren(node, ray.origin, invDir,
+            static_cast<Math::Real>(tMax), tEntry);
+
+        // Push the hit children farthest first so the nearest is popped
+        // next, insertion sorting the few of them on the stack top
+        std::size_t base = stackSize;
+        for (int i = 0; i < WIDTH; i++) {
+            if (!(mask & (1u << i)) || node.child[i] == EMPTY)
+                continue;
+            StackEntry child = { node.child[i], node.count[i], tEntry[i] };
+            std::size_t j = stackSize++;
+            for (; j > base && stack[j - 1].tEntry < child.tEntry; j--)
+                stack[j] = stack[j - 1];
+            stack[j] = child;
+        }
+    }
+    return hit;
+}
+
+// Slab test of one box against every lane of a packet, same arithmetic as
+// AABB::intersect without the branches
+inline bool anyLaneHits(const AABB& box, const RayPacket& packet,
+    const Math::Real* invX, const Math::Real* invY, const Math::Real* invZ,
+    const double* tMax)
+{
+    const Math::Real widen = 1 + 4 * std::numeric_limits<Math::Real>::epsilon();
+    bool hit = false;
+
+    for (int i = 0; i < RayPacket::SIZE; i++) {
+        Math::Real t0 = (box.min.x - packet.ox[i]) * invX[i];
+        Math::Real t1 = (box.max.x - packet.ox[i]) * invX[i];
+        Math::Real near = std::max<Math::Real>(0, std::min(t0, t1));
+        Math::Real far = std::min<Math::Real>(tMax[i], std::max(t0, t1));
+
+        t0 = (box.min.y - packet.oy[i]) * invY[i];
+        t1 = (box.max.y - packet.oy[i]) * invY[i];
+        near = std::max(near, std::min(t0, t1));
+        far = std::min(far, std::max(t0, t1));
+
+        t0 = (box.min.z - packet.oz[i]) * invZ[i];
+        t1 = (box.max.z - packet.oz[i]) * invZ[i];
+        near = std::max(near, std::min(t0, t1));
+        far = std::min(far, std::max(t0, t1));
+
+        hit |= near <= far * widen;
+    }
+    return hit;
+}
+
+template <typename LeafFunc>
+void BVH::intersectPacket(const RayPacket& packet, double* tMax,
+    LeafFunc&& leaf) const
+{
+    if (_nodes.empty() || packet.count == 0)
+        return;
+
+    alignas(32) Math::Real invX[RayPacket::SIZE];
+    alignas(32) Math::Real invY[RayPacket::SIZE];
+    alignas(32) Math::Real invZ[RayPacket::SIZE];
+    for (int i = 0; i < RayPacket::SIZE; i++) {
+        invX[i] = 1 / packet.dx[i];
+        invY[i] = 1 / packet.dy[i];
+        invZ[i] = 1 / packet.dz[i];
+    }
+
+    std::uint32_t stack[STACK_SIZE];
+    std::size_t stackSize = 0;
+
+    stack[stackSize++] = 0;
+    while (stackSize > 0) {
+        const Node& node = _nodes[stack[--stackSize]];
+
+        for (int c = 0; c < WIDTH; c++) {
+            if (node.child[c] == EMPTY)
+                continue;
+            AABB box(Math::Point3D(node.minX[c], node.minY[c], node.minZ[c]),
+                Math::Point3D(node.maxX[c], node.maxY[c], node.maxZ[c]));
+            if (!anyLaneHits(box, packet, invX, invY, invZ, tMax))
+                continue;
+
+            if (node.count[c] > 0) {
+                for (std::uint32_t i = 0; i < node.count[c]; i++)
+                    leaf(_indices[node.child[c] + i], tMax);
+            } else {
+                stack[stackSize++] = node.child[c];
+            }
+        }
+    }
+}
+
+template <typename LeafFunc>
+bool BVH::occluded(const Ray& ray, double tMax, LeafFunc&& leaf) const
+{
+    if (_nodes.empty())
+        return false;
+
+    Math::Vector3D invDir = inverseDirection(ray.direction);
+    std::uint32_t stack[STACK_SIZE];
+    std::size_t stackSize = 0;
+    alignas(32) Math::Real tEntry[WIDTH];
+
+    stack[stackSize++] = 0;
+    while (stackSize > 0) {
+        const Node& node = _nodes[stack[--stackSize]];
+        unsigned mask = intersectChildren(node, ray.origin, invDir,
+            static_cast<Math::Real>(tMax), tEntry);
+
+        for (int c = 0; c < WIDTH; c++) {
+            if (!(mask & (1u << c)) || node.child[c] == EMPTY)
+                continue;
+            if (node.count[c] == 0) {
+                stack[stackSize++] = node.child[c];
+                continue;
+            }
+            for (std::uint32_t i = 0; i < node.count[c]; i++) {
+                if (leaf(_indices[node.child[c] + i], tMax))
+                    return true;
+            }
+        }
+    }
+    return false;
+}
+
+} // namespace Raytracer
+
+#endif /* RAYTRACER_BVH_HPP */
@@ -0,0 +1,89 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** Buffer.hpp
+*/
+
+#ifndef RAYTRACER_BUFFER_HPP
+#define RAYTRACER_BUFFER_HPP
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Raytracer {
+
+// Read-only array that either owns its elements or points into memory
+// owned by someone else, such as a mapped cache file. The owner is kept
+// alive as long as a buffer points into it.
+template <typename T>
+class Buffer {
+public:
+    Buffer() = default;
+
+    Buffer(std::vector<T> values)
+        : _owned(std::move(values))
+        , _data(_owned.data())
+        , _size(_owned.size())
+    {
+    }
+
+    Buffer(const T* data, std::size_t size, std::shared_ptr<const void> owner)
+        : _owner(std::move(owner))
+        , _data(data)
+        , _size(size)
+    {
+    }
+
+    Buffer(const Buffer& other)
+        : _owned(other._owned)
+        , _owner(other._owner)
+        , _data(other._owner ? other._data : _owned.data())
+        , _size(other._size)
+    {
+    }
+
+    // Moving a vector keeps its storage, so _data stays valid. The source
+    // is left empty rather than pointing at what it gave away.
+    Buffer(Buffer&& other) noexcept
+        : _owned(std::move(other._owned))
+        , _owner(std::move(other._owner))
+        , _data(std::exchange(other._data, nullptr))
+        , _size(std::exchange(other._size, 0))
+    {
+        other._owned.clear();
+    }
+
+    // Takes other by value, so a moved-from source is emptied by the move
+    // constructor above
+    Buffer& operator=(Buffer other) noexcept
+    {
+        std::swap(_owned, other._owned);
+        std::swap(_owner, other._owner);
+        std::swap(_data, other._data);
+        std::swap(_size, other._size);
+        return *this;
+    }
+
+    const T& operator[](std::size_t i) const { return _data[i]; }
+    const T* data() const { return _data; }
+    const T* begin() const { return _data; }
+    const T* end() const { return _data + _size; }
+    std::size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+    // Heap bytes held by the buffer, mapped memory is not counted
+    std::size_t memoryUsage() const { return _owned.capacity() * sizeof(T); }
+
+private:
+    std::vector<T> _owned;
+    std::shared_ptr<const void> _owner;
+    const T* _data = nullptr;
+    std::size_t _size = 0;
+};
+
+} // namespace Raytracer
+
+#endif /* RAYTRACER_BUFFER_HPP */
@@ -10,6 +10,7 @@
  */
 
 #include "Camera.hpp"
+#include <cmath>
 
 namespace Raytracer {
 
@@ -17,7 +18,7 @@ Camera::Camera(Math::Point3D origin, Math::Point3D screenOrigin, int resX,
     int resY)
     : origin(origin)
     , // TO DO: MUST MAKE THIS DYNAMIC
-    screen(screenOrigin, { 1.0 * static_cast<double>(resX) / resY, 0, 0 },
+    screen(screenOrigin, { static_cast<Math::Real>(1.0 * resX / resY), 0, 0 },
         { 0, 1.0, 0 })
     , resolution({ resX, resY })
     , rotation(0.0, 0.0, 0.0)
@@ -139,4 +140,39 @@ Ray Camera::ray(double u, double v) const
     return Ray(origin, direction);
 }
 
+void Camera::rays(const double* u, const double* v, int count,
+    RayPacket& packet) const
+{
+    // Same operations as ray(), one component at a time so that each
+    // line is a loop over the lanes
+    Math::Real tx[RayPacket::SIZE];
+    Math::Real ty[RayPacket::SIZE];
+    Math::Real tz[RayPacket::SIZE];
+
+    packet.count = count;
+    for (int i = 0; i < count; i++) {
+        Math::Real su = static_cast<Math::Real>(2.0 * u[i] - 1.0);
+        Math::Real sv = static_cast<Math::Real>(1.0 - 2.0 * v[i]);
+        tx[i] = screen.origin.x + screen.bottom_side.x * su + screen.left_side.x * sv;
+        ty[i] = screen.origin.y + screen.bottom_side.y * su + screen.left_side.y * sv;
+        tz[i] = screen.origin.z + screen.bottom_side.z * su + screen.left_side.z * sv;
+    }
+    for (int i = 0; i < count; i++) {
+        Math::Real x = tx[i] - origin.x;
+        Math::Real y = ty[i] - origin.y;
+        Math::Real z = tz[i] - origin.z;
+        Math::Real len = std::sqrt(x * x + y * y + z * z);
+        Math::Real scale = len == 0 ? 0 : 1;
+        Math::Real div = len == 0 ? 1 : len;
+
+        packet.ox[i] = origin.x;
+        packet.oy[i] = origin.y;
+        packet.oz[i] = origin.z;
+        packet.dx[i] = scale * (x / div);
+        packet.dy[i] = scale * (y / div);
+        packet.dz[i] = scale * (z / div);
+    }
+    packet.pad();
+}
+
 } // namespace Raytracer
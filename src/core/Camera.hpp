@@ -20,6 +20,7 @@
 #define RAYTRACER_CAMERA_HPP_
 
 #include "Ray.hpp"
+#include "RayPacket.hpp"
 #include "Rectangle3D.hpp"
 
 namespace Raytracer {
@@ -57,6 +58,10 @@ public:
     double getFieldOfView() const { return fieldOfView; }
 
     Ray ray(double u, double v) const;
+    // ray() for count <= RayPacket::SIZE screen positions at once, the
+    // packet is padded past count
+    void rays(const double* u, const double* v, int count,
+        RayPacket& packet) const;
 
 private:
     Resolution resolution;
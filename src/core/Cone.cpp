@@ -18,6 +18,7 @@
 #include "Cone.hpp"
 #include "../factories/MaterialFactory.hpp"
 #include "../utils/Debug.hpp"
+#include <algorithm>
 #include <cmath>
 #include <memory>
 #include <stdexcept>
@@ -59,7 +60,7 @@ Cone::Cone(const libconfig::Setting& settings)
         settings.lookupValue("y", y);
         settings.lookupValue("z", z);
         settings.lookupValue("r", r);
-        position = Math::Vector3D(x, y, z);
+        setPosition(Math::Vector3D(x, y, z));
         if (!settings.lookupValue("h", h)) {
             h = -1.0; // Default to infinite cone if height not specified
         }
@@ -263,12 +264,26 @@ double Cone::getTopRadius() const
     return radius * (1.0 - cut_height / height);
 }
 
-std::unique_ptr<IMaterial> Cone::getMaterial() const
+AABB Cone::localBoundingBox() const
 {
-    if (material) {
-        return material->clone();
+    if (height == -1) {
+        return AABB::infinite();
     }
-    return nullptr;
+
+    // Union of the base disc and the top disc (a point when the cone is not cut)
+    Math::Vector3D discAxis(std::sqrt(std::max(0.0, 1.0 - direction.x * direction.x)),
+        std::sqrt(std::max(0.0, 1.0 - direction.y * direction.y)),
+        std::sqrt(std::max(0.0, 1.0 - direction.z * direction.z)));
+    Math::Point3D top = base + direction * (cut_height > 0 ? cut_height : height);
+    Math::Vector3D baseExtent = discAxis * radius;
+    Math::Vector3D topExtent = discAxis * getTopRadius();
+
+    AABB box;
+    box.expand(base + baseExtent);
+    box.expand(base + -baseExtent);
+    box.expand(top + topExtent);
+    box.expand(top + -topExtent);
+    return box;
 }
 
 bool Cone::isPlane() const
@@ -41,12 +41,12 @@ public:
         double cut_height = -1);
     Cone(const libconfig::Setting& settings);
 
-    std::unique_ptr<IMaterial> getMaterial() const override;
     bool isPlane() const override;
 
 protected:
     double localHits(const Ray& localRay) const override;
     Math::Vector3D localGetNormal(const Math::Point3D& localPoint) const override;
+    AABB localBoundingBox() const override;
 
     bool isOnBase(const Math::Point3D& point) const;
     bool isOnTopBase(const Math::Point3D& point) const;
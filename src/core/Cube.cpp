@@ -50,7 +50,7 @@ Cube::Cube(const libconfig::Setting& settings)
         settings.lookupValue("y", y);
         settings.lookupValue("z", z);
         settings.lookupValue("side", s);
-        position = Math::Vector3D(x, y, z);
+        setPosition(Math::Vector3D(x, y, z));
         center = Math::Point3D(0, 0, 0);
 
         side = s;
@@ -67,16 +67,16 @@ Cube::Cube(const libconfig::Setting& settings)
 
 double Cube::localHits(const Ray& localRay) const
 {
-    double halfSide = side / 2.0;
+    Math::Real halfSide = side / 2;
     Math::Point3D min(center.x - halfSide, center.y - halfSide, center.z - halfSide);
     Math::Point3D max(center.x + halfSide, center.y + halfSide, center.z + halfSide);
 
-    double tx1 = (min.x - localRay.origin.x) / localRay.direction.x;
-    double tx2 = (max.x - localRay.origin.x) / localRay.direction.x;
-    double ty1 = (min.y - localRay.origin.y) / localRay.direction.y;
-    double ty2 = (max.y - localRay.origin.y) / localRay.direction.y;
-    double tz1 = (min.z - localRay.origin.z) / localRay.direction.z;
-    double tz2 = (max.z - localRay.origin.z) / localRay.direction.z;
+    Math::Real tx1 = (min.x - localRay.origin.x) / localRay.direction.x;
+    Math::Real tx2 = (max.x - localRay.origin.x) / localRay.direction.x;
+    Math::Real ty1 = (min.y - localRay.origin.y) / localRay.direction.y;
+    Math::Real ty2 = (max.y - localRay.origin.y) / localRay.direction.y;
+    Math::Real tz1 = (min.z - localRay.origin.z) / localRay.direction.z;
+    Math::Real tz2 = (max.z - localRay.origin.z) / localRay.direction.z;
 
     if (tx1 > tx2)
         std::swap(tx1, tx2);
@@ -85,8 +85,8 @@ double Cube::localHits(const Ray& localRay) const
     if (tz1 > tz2)
         std::swap(tz1, tz2);
 
-    double tmin = std::max(std::max(tx1, ty1), tz1);
-    double tmax = std::min(std::min(tx2, ty2), tz2);
+    Math::Real tmin = std::max(std::max(tx1, ty1), tz1);
+    Math::Real tmax = std::min(std::min(tx2, ty2), tz2);
 
     if (tmax < 0)
         return -1;
@@ -98,6 +98,33 @@ double Cube::localHits(const Ray& localRay) const
     return tmin;
 }
 
+void Cube::localHitsPacket(const RayPacket& packet, double* t) const
+{
+    Math::Real halfSide = side / 2;
+    Math::Point3D min(center.x - halfSide, center.y - halfSide, center.z - halfSide);
+    Math::Point3D max(center.x + halfSide, center.y + halfSide, center.z + halfSide);
+
+    for (int i = 0; i < RayPacket::SIZE; i++) {
+        Math::Real tx1 = (min.x - packet.ox[i]) / packet.dx[i];
+        Math::Real tx2 = (max.x - packet.ox[i]) / packet.dx[i];
+        Math::Real ty1 = (min.y - packet.oy[i]) / packet.dy[i];
+        Math::Real ty2 = (max.y - packet.oy[i]) / packet.dy[i];
+        Math::Real tz1 = (min.z - packet.oz[i]) / packet.dz[i];
+        Math::Real tz2 = (max.z - packet.oz[i]) / packet.dz[i];
+
+        // Selects instead of localHits' swaps, NaNs end up on the same side
+        Math::Real tmin = std::max(std::max(tx1 > tx2 ? tx2 : tx1,
+                                       ty1 > ty2 ? ty2 : ty1),
+            tz1 > tz2 ? tz2 : tz1);
+        Math::Real tmax = std::min(std::min(tx1 > tx2 ? tx1 : tx2,
+                                       ty1 > ty2 ? ty1 : ty2),
+            tz1 > tz2 ? tz1 : tz2);
+
+        Math::Real hit = tmin < 0 ? tmax : tmin;
+        t[i] = (tmax < 0 || tmin > tmax) ? -1 : hit;
+    }
+}
+
 Math::Vector3D Cube::localGetNormal(const Math::Point3D& localPoint) const
 {
     double halfSide = side / 2.0;
@@ -115,12 +142,11 @@ Math::Vector3D Cube::localGetNormal(const Math::Point3D& localPoint) const
     return dir.normalize();
 }
 
-std::unique_ptr<IMaterial> Cube::getMaterial() const
+AABB Cube::localBoundingBox() const
 {
-    if (material) {
-        return material->clone();
-    }
-    return MaterialFactory::createDefaultMaterial();
+    double halfSide = side / 2.0;
+    return AABB(Math::Point3D(center.x - halfSide, center.y - halfSide, center.z - halfSide),
+        Math::Point3D(center.x + halfSide, center.y + halfSide, center.z + halfSide));
 }
 
 bool Cube::isPlane() const
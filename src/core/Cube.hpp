@@ -35,10 +35,11 @@ public:
 
 protected:
     double localHits(const Ray& ray) const override;
+    void localHitsPacket(const RayPacket& packet, double* t) const override;
     Math::Vector3D localGetNormal(const Math::Point3D& point) const override;
+    AABB localBoundingBox() const override;
 
 public:
-    std::unique_ptr<IMaterial> getMaterial() const override;
     bool isPlane() const override;
 };
 
@@ -20,6 +20,7 @@
 #include "Cylinder.hpp"
 #include "../factories/MaterialFactory.hpp"
 #include "../utils/Debug.hpp"
+#include <algorithm>
 #include <cmath>
 #include <memory>
 #include <stdexcept>
@@ -53,7 +54,7 @@ Cylinder::Cylinder(const libconfig::Setting& settings)
         settings.lookupValue("x", x_int);
         settings.lookupValue("y", y_int);
         settings.lookupValue("z", z_int);
-        position = Math::Vector3D(x_int, y_int, z_int);
+        setPosition(Math::Vector3D(x_int, y_int, z_int));
         center = Math::Point3D(0, 0, 0);
 
         // Read cylinder axis direction (default to y-axis if not specified)
@@ -396,7 +397,7 @@ Math::Vector3D Cylinder::localGetNormal(const Math::Point3D& point) const
             axis.z * fallback_vec.x - axis.x * fallback_vec.z,
             axis.x * fallback_vec.y - axis.y * fallback_vec.x);
 
-        Debug::log("Warning: Using fallback normal for cylinder hit at (", point.x, ", ", point.y, ", ", point.z, ")");
+        RT_LOG_TRACE("Warning: Using fallback normal for cylinder hit at (", point.x, ", ", point.y, ", ", point.z, ")");
 
         return perp1.normalize();
     }
@@ -404,6 +405,25 @@ Math::Vector3D Cylinder::localGetNormal(const Math::Point3D& point) const
     return normal.normalize();
 }
 
+AABB Cylinder::localBoundingBox() const
+{
+    if (!limited) {
+        return AABB::infinite();
+    }
+
+    // A disc of radius r around the axis extends r * sqrt(1 - axis_i^2) along each world axis
+    Math::Vector3D extent(radius * std::sqrt(std::max(0.0, 1.0 - axis.x * axis.x)),
+        radius * std::sqrt(std::max(0.0, 1.0 - axis.y * axis.y)),
+        radius * std::sqrt(std::max(0.0, 1.0 - axis.z * axis.z)));
+
+    AABB box;
+    box.expand(center + extent);
+    box.expand(center + -extent);
+    box.expand(topCenter + extent);
+    box.expand(topCenter + -extent);
+    return box;
+}
+
 bool Cylinder::isPlane() const
 {
     return false;
@@ -73,6 +73,7 @@ public:
 
     double localHits(const Ray& ray) const override;
     Math::Vector3D localGetNormal(const Math::Point3D& point) const override;
+    AABB localBoundingBox() const override;
     bool isPlane() const override;
 };
 
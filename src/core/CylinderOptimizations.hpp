@@ -18,83 +18,11 @@
 #ifndef RAYTRACER_CYLINDER_OPTIMIZATIONS_HPP
 #define RAYTRACER_CYLINDER_OPTIMIZATIONS_HPP
 
+#include "AABB.hpp"
 #include "Cylinder.hpp"
 
 namespace Raytracer {
 
-// Bounding Box Structure
-struct AABB {
-    Math::Point3D min; // Minimum coordinates
-    Math::Point3D max; // Maximum coordinates
-
-    AABB() = default;
-
-    AABB(const Math::Point3D& min, const Math::Point3D& max)
-        : min(min)
-        , max(max)
-    {
-    }
-
-    bool intersect(const Ray& ray) const
-    {
-        // Track the smallest and largest t values along each dimension
-        double tx_min, tx_max, ty_min, ty_max, tz_min, tz_max;
-
-        // Calculate inverse ray direction for optimization
-        double inv_dx = 1.0 / ray.direction.x;
-        double inv_dy = 1.0 / ray.direction.y;
-        double inv_dz = 1.0 / ray.direction.z;
-
-        // Calculate t values for x-planes
-        if (inv_dx >= 0) {
-            tx_min = (min.x - ray.origin.x) * inv_dx;
-            tx_max = (max.x - ray.origin.x) * inv_dx;
-        } else {
-            tx_min = (max.x - ray.origin.x) * inv_dx;
-            tx_max = (min.x - ray.origin.x) * inv_dx;
-        }
-
-        // Calculate t values for y-planes
-        if (inv_dy >= 0) {
-            ty_min = (min.y - ray.origin.y) * inv_dy;
-            ty_max = (max.y - ray.origin.y) * inv_dy;
-        } else {
-            ty_min = (max.y - ray.origin.y) * inv_dy;
-            ty_max = (min.y - ray.origin.y) * inv_dy;
-        }
-
-        // If we miss along any dimension, we miss the box
-        if (tx_min > ty_max || ty_min > tx_max) {
-            return false;
-        }
-
-        // Update tmin and tmax
-        double t_min = (tx_min > ty_min) ? tx_min : ty_min;
-        double t_max = (tx_max < ty_max) ? tx_max : ty_max;
-
-        // Calculate t values for z-planes
-        if (inv_dz >= 0) {
-            tz_min = (min.z - ray.origin.z) * inv_dz;
-            tz_max = (max.z - ray.origin.z) * inv_dz;
-        } else {
-            tz_min = (max.z - ray.origin.z) * inv_dz;
-            tz_max = (min.z - ray.origin.z) * inv_dz;
-        }
-
-        // If we miss along the z dimension, we miss the box
-        if (t_min > tz_max || tz_min > t_max) {
-            return false;
-        }
-
-        // Update tmin and tmax
-        t_min = (t_min > tz_min) ? t_min : tz_min;
-        t_max = (t_max < tz_max) ? t_max : tz_max;
-
-        // Check if the box is behind the ray
-        return (t_max > 0);
-    }
-};
-
 class OptimizedCylinder : public Cylinder {
 private:
     AABB boundingBox;
@@ -0,0 +1,255 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** MeshData.cpp
+*/
+
+#include "MeshData.hpp"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace Raytracer {
+
+MeshData::MeshData(std::vector<float> x, std::vector<float> y,
+    std::vector<float> z, std::vector<std::uint32_t> indices,
+    MeshNormals normals)
+{
+    _data.x = std::move(x);
+    _data.y = std::move(y);
+    _data.z = std::move(z);
+    _data.indices = std::move(indices);
+    _data.normalX = std::move(normals.x);
+    _data.normalY = std::move(normals.y);
+    _data.normalZ = std::move(normals.z);
+    _data.normalIndices = std::move(normals.indices);
+    validate();
+
+    std::vector<AABB> boxes;
+    std::vector<Math::Vector3D> faceNormals;
+    boxes.reserve(getTriangleCount());
+    faceNormals.reserve(getTriangleCount());
+    for (std::size_t i = 0; i < getTriangleCount(); i++) {
+        const std::uint32_t* face = &_data.indices[3 * i];
+        Math::Point3D v1 = vertex(face[0]);
+        Math::Point3D v2 = vertex(face[1]);
+        Math::Point3D v3 = vertex(face[2]);
+
+        AABB box;
+        box.expand(v1);
+        box.expand(v2);
+        box.expand(v3);
+        boxes.push_back(box);
+        faceNormals.push_back((v2 - v1).cross(v3 - v1).normalize());
+    }
+    _data.faceNormals = std::move(faceNormals);
+
+    // Leaves start on a block boundary, so each one is tested a block of
+    // triangles at a time
+    _data.bvh.build(boxes, 4, TriangleBlock::WIDTH);
+
+    const Buffer<std::uint32_t>& order = _data.bvh.getIndices();
+    std::vector<TriangleBlock> blocks(order.size() / TriangleBlock::WIDTH);
+    for (std::size_t i = 0; i < order.size(); i++) {
+        TriangleBlock& block = blocks[i / TriangleBlock::WIDTH];
+        std::size_t slot = i % TriangleBlock::WIDTH;
+        if (order[i] == BVH::EMPTY)
+            continue;
+        const std::uint32_t* face = &_data.indices[3 * order[i]];
+        block.ax[slot] = _data.x[face[0]];
+        block.ay[slot] = _data.y[face[0]];
+        block.az[slot] = _data.z[face[0]];
+        block.bx[slot] = _data.x[face[1]];
+        block.by[slot] = _data.y[face[1]];
+        block.bz[slot] = _data.z[face[1]];
+        block.cx[slot] = _data.x[face[2]];
+        block.cy[slot] = _data.y[face[2]];
+        block.cz[slot] = _data.z[face[2]];
+    }
+    _data.blocks = std::move(blocks);
+}
+
+MeshData::MeshData(MeshBuffers buffers)
+    : _data(std::move(buffers))
+{
+    validate();
+
+    const Buffer<std::uint32_t>& order = _data.bvh.getIndices();
+    if (_data.faceNormals.size() != getTriangleCount())
+        throw std::invalid_argument("Mesh face normals do not match the faces");
+    if (order.size() % TriangleBlock::WIDTH != 0
+        || _data.blocks.size() != order.size() / TriangleBlock::WIDTH)
+        throw std::invalid_argument("Mesh blocks do not match its BVH");
+    for (const BVH::Node& node : _data.bvh.getNodes()) {
+        for (int c = 0; c < BVH::WIDTH; c++) {
+            if (node.child[c] != BVH::EMPTY && node.count[c] > 0
+                && node.child[c] % TriangleBlock::WIDTH != 0)
+                throw std::invalid_argument("Mesh BVH leaves are not aligned on blocks");
+        }
+    }
+}
+
+void MeshData::validate() const
+{
+    const MeshBuffers& d = _data;
+    if (d.x.size() != d.y.size() || d.x.size() != d.z.size())
+        throw std::invalid_argument("Mesh vertex arrays have different sizes");
+    if (d.indices.size() % 3 != 0)
+        throw std::invalid_argument("Mesh index count is not a multiple of 3");
+    if (d.normalX.size() != d.normalY.size() || d.normalX.size() != d.normalZ.size())
+        throw std::invalid_argument("Mesh normal arrays have different sizes");
+    if (!d.normalIndices.empty() && d.normalIndices.size() != d.indices.size())
+        throw std::invalid_argument("Mesh normal indices do not match the faces");
+
+    // Bitwise tests keep the loops free of branches
+    bool missing = false;
+    for (std::uint32_t index : d.indices)
+        missing |= index >= d.x.size();
+    if (missing)
+        throw std::out_of_range("Mesh face references a missing vertex");
+    for (std::uint32_t index : d.normalIndices)
+        missing |= (index != MeshNormals::NONE) & (index >= d.normalX.size());
+    if (missing)
+        throw std::out_of_range("Mesh face references a missing normal");
+}
+
+double MeshData::intersect(const Ray& ray, std::size_t& triangle) const
+{
+    const Buffer<std::uint32_t>& order = _data.bvh.getIndices();
+    WatertightRay watertight(ray);
+    double closest = std::numeric_limits<double>::max();
+    double t[TriangleBlock::WIDTH];
+
+    bool hit = _data.bvh.intersectLeaves(ray, closest,
+        [&](std::uint32_t first, std::uint32_t count, double& tMax) {
+            bool found = false;
+            for (std::uint32_t i = first; i < first + count; i += TriangleBlock::WIDTH) {
+                Watertight::intersect(watertight, _data.blocks[i / TriangleBlock::WIDTH], t);
+                for (int slot = 0; slot < TriangleBlock::WIDTH; slot++) {
+                    if (t[slot] > 0 && t[slot] < tMax) {
+                        tMax = t[slot];
+                        triangle = order[i + slot];
+                        found = true;
+                    }
+                }
+            }
+            return found;
+        });
+
+    return hit ? closest : -1;
+}
+
+void MeshData::intersectPacket(const RayPacket& packet, double* t,
+    std::size_t* triangle) const
+{
+    double closest[RayPacket::SIZE];
+    WatertightRay lanes[RayPacket::SIZE];
+
+    for (int i = 0; i < RayPacket::SIZE; i++) {
+        closest[i] = std::numeric_limits<double>::max();
+        triangle[i] = 0;
+        lanes[i] = WatertightRay(packet.ray(i));
+    }
+
+    _data.bvh.intersectPacket(packet, closest, [&](std::uint32_t index, double* tMax) {
+        const std::uint32_t* face = &_data.indices[3 * index];
+        Math::Point3D v1 = vertex(face[0]);
+        Math::Point3D v2 = vertex(face[1]);
+        Math::Point3D v3 = vertex(face[2]);
+
+        for (int i = 0; i < RayPacket::SIZE; i++) {
+            double hit = Watertight::intersect(lanes[i], v1, v2, v3);
+            if (hit > 0 && hit < tMax[i]) {
+                tMax[i] = hit;
+                triangle[i] = index;
+            }
+        }
+    });
+
+    for (int i = 0; i < RayPacket::SIZE; i++)
+        t[i] = closest[i] < std::numeric_limits<double>::max() ? closest[i] : -1;
+}
+
+Math::Vector3D MeshData::getNormal(std::size_t triangle) const
+{
+    return _data.faceNormals[triangle];
+}
+
+Math::Vector3D MeshData::getNormal(std::size_t triangle,
+    const Math::Point3D& point) const
+{
+    if (_data.normalIndices.empty())
+        return _data.faceNormals[triangle];
+
+    const std::uint32_t* corners = &_data.normalIndices[3 * triangle];
+    if (corners[0] == MeshNormals::NONE || corners[1] == MeshNormals::NONE
+        || corners[2] == MeshNormals::NONE)
+        return _data.faceNormals[triangle];
+
+    const std::uint32_t* face = &_data.indices[3 * triangle];
+    Math::Point3D v1 = vertex(face[0]);
+    Math::Vector3D edge1 = vertex(face[1]) - v1;
+    Math::Vector3D edge2 = vertex(face[2]) - v1;
+    Math::Vector3D normal = edge1.cross(edge2);
+    double area2 = normal.dot(normal);
+    if (area2 <= 0)
+        return _data.faceNormals[triangle];
+
+    // Barycentric weights of the point, as in findTriangle()
+    Math::Vector3D p = point - v1;
+    double u = p.cross(edge2).dot(normal) / area2;
+    double v = edge1.cross(p).dot(normal) / area2;
+    double w = 1.0 - u - v;
+
+    Math::Vector3D shading(
+        w * _data.normalX[corners[0]] + u * _data.normalX[corners[1]] + v * _data.normalX[corners[2]],
+        w * _data.normalY[corners[0]] + u * _data.normalY[corners[1]] + v * _data.normalY[corners[2]],
+        w * _data.normalZ[corners[0]] + u * _data.normalZ[corners[1]] + v * _data.normalZ[corners[2]]);
+    if (!(shading.dot(normal) > 0))
+        return _data.faceNormals[triangle];
+    return shading.normalize();
+}
+
+std::size_t MeshData::findTriangle(const Math::Point3D& point) const
+{
+    std::size_t best = 0;
+    double bestDistance = std::numeric_limits<double>::infinity();
+
+    for (std::size_t i = 0; i < getTriangleCount(); i++) {
+        const std::uint32_t* face = &_data.indices[3 * i];
+        Math::Point3D v1 = vertex(face[0]);
+        Math::Vector3D edge1 = vertex(face[1]) - v1;
+        Math::Vector3D edge2 = vertex(face[2]) - v1;
+        Math::Vector3D normal = edge1.cross(edge2);
+        double area2 = normal.dot(normal);
+        if (area2 <= 0)
+            continue;
+
+        // Barycentric coordinates of the point projected onto the face
+        Math::Vector3D p = point - v1;
+        double u = p.cross(edge2).dot(normal) / area2;
+        double v = edge1.cross(p).dot(normal) / area2;
+        if (u < -1e-6 || v < -1e-6 || u + v > 1.0 + 1e-6)
+            continue;
+
+        double distance = std::abs(p.dot(normal)) / std::sqrt(area2);
+        if (distance < bestDistance) {
+            bestDistance = distance;
+            best = i;
+        }
+    }
+    return best;
+}
+
+std::size_t MeshData::memoryUsage() const
+{
+    const MeshBuffers& d = _data;
+    return d.x.memoryUsage() + d.y.memoryUsage() + d.z.memoryUsage()
+        + d.indices.memoryUsage() + d.normalX.memoryUsage() + d.normalY.memoryUsage()
+        + d.normalZ.memoryUsage() + d.normalIndices.memoryUsage()
+        + d.faceNormals.memoryUsage() + d.blocks.memoryUsage()
+        + d.bvh.getNodes().memoryUsage() + d.bvh.getIndices().memoryUsage();
+}
+
+} // namespace Raytracer
@@ -0,0 +1,109 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** MeshData.hpp
+*/
+
+#ifndef RAYTRACER_MESHDATA_HPP
+#define RAYTRACER_MESHDATA_HPP
+
+#include "AABB.hpp"
+#include "BVH.hpp"
+#include "Buffer.hpp"
+#include "Point3D.hpp"
+#include "Ray.hpp"
+#include "RayPacket.hpp"
+#include "Vector3D.hpp"
+#include "WatertightTriangle.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Raytracer {
+
+// Shading normals of a mesh: a normal array and one normal index per
+// triangle corner. Faces with a NONE corner keep their face normal.
+struct MeshNormals {
+    static constexpr std::uint32_t NONE = 0xffffffff;
+
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+    std::vector<std::uint32_t> indices;
+};
+
+// Every buffer of a built mesh, which MeshCache saves and maps back
+struct MeshBuffers {
+    Buffer<float> x;
+    Buffer<float> y;
+    Buffer<float> z;
+    Buffer<std::uint32_t> indices;
+    // Shading normals and their corner indices, see MeshNormals
+    Buffer<float> normalX;
+    Buffer<float> normalY;
+    Buffer<float> normalZ;
+    Buffer<std::uint32_t> normalIndices;
+    // Unit face normals, in face order
+    Buffer<Math::Vector3D> faceNormals;
+    // Faces in BVH index order, padding slots left degenerate
+    Buffer<TriangleBlock> blocks;
+    BVH bvh;
+};
+
+// Immutable triangle soup: vertex positions stored as separate x/y/z float
+// arrays, three vertex indices per triangle and a BVH over the triangles.
+// Rays are tested against copies of the triangles laid out in BVH leaf
+// order, TriangleBlock::WIDTH at a time, and face normals are computed
+// once at load. Optional shading normals are interpolated across faces.
+// Meshes are shared through std::shared_ptr<const MeshData>.
+class MeshData {
+public:
+    MeshData(std::vector<float> x, std::vector<float> y, std::vector<float> z,
+        std::vector<std::uint32_t> indices, MeshNormals normals = {});
+    // Takes over the buffers of an earlier mesh without computing anything
+    // again. Throws std::invalid_argument when they do not fit together.
+    explicit MeshData(MeshBuffers buffers);
+
+    std::size_t getVertexCount() const { return _data.x.size(); }
+    std::size_t getTriangleCount() const { return _data.indices.size() / 3; }
+    const AABB& getBounds() const { return _data.bvh.getBounds(); }
+    const MeshBuffers& getBuffers() const { return _data; }
+
+    // Closest triangle hit, -1 on a miss. triangle receives the face index.
+    double intersect(const Ray& ray, std::size_t& triangle) const;
+
+    // intersect() for every lane of a packet, with one traversal
+    void intersectPacket(const RayPacket& packet, double* t,
+        std::size_t* triangle) const;
+
+    // Geometric normal of a face, following the vertex winding order
+    Math::Vector3D getNormal(std::size_t triangle) const;
+
+    // Shading normal at a point of a face, interpolated from the corner
+    // normals. Falls back to the face normal when the face has none or
+    // when the interpolated normal points to the other side of the face.
+    Math::Vector3D getNormal(std::size_t triangle, const Math::Point3D& point) const;
+
+    // Face lying closest to a point, for callers that lost track of the
+    // face they hit. Linear in the triangle count.
+    std::size_t findTriangle(const Math::Point3D& point) const;
+
+    // Heap bytes held by the vertex, index, normal and BVH buffers
+    std::size_t memoryUsage() const;
+
+private:
+    // Checks that the buffers fit together and reference existing items
+    void validate() const;
+
+    Math::Point3D vertex(std::uint32_t index) const
+    {
+        return Math::Point3D(_data.x[index], _data.y[index], _data.z[index]);
+    }
+
+    MeshBuffers _data;
+};
+
+} // namespace Raytracer
+
+#endif /* RAYTRACER_MESHDATA_HPP */
@@ -65,6 +65,29 @@ double Plane::hits(const Ray& ray) const
     return -1.0;
 }
 
+void Plane::hitsPacket(const RayPacket& packet, double* t,
+    std::size_t* element) const
+{
+    // The axis is resolved once per packet instead of once per ray
+    const Math::Real* rayOrigin = packet.oz;
+    const Math::Real* rayDirection = packet.dz;
+
+    if (axis == "X") {
+        rayOrigin = packet.ox;
+        rayDirection = packet.dx;
+    } else if (axis == "Y") {
+        rayOrigin = packet.oy;
+        rayDirection = packet.dy;
+    }
+
+    for (int i = 0; i < RayPacket::SIZE; i++) {
+        double distance = (position - rayOrigin[i]) / rayDirection[i];
+        bool miss = std::abs(rayDirection[i]) < 0.0001 || !(distance >= 0);
+        t[i] = miss ? -1.0 : distance;
+        element[i] = 0;
+    }
+}
+
 Math::Vector3D Plane::getNormal(const Math::Point3D& point) const
 {
     (void)point;
@@ -77,14 +100,7 @@ Math::Vector3D Plane::getNormal(const Math::Point3D& point) const
     }
 }
 
-std::unique_ptr<IMaterial> Plane::getMaterial() const
-{
-    if (material) {
-        return material->clone();
-    } else {
-        return MaterialFactory::createDefaultMaterial();
-    }
-}
+AABB Plane::getBoundingBox() const { return AABB::infinite(); }
 
 bool Plane::isPlane() const { return true; }
 
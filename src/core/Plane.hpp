@@ -25,9 +25,11 @@ public:
     Plane(const libconfig::Setting& settings);
 
     double hits(const Ray& ray) const override;
+    void hitsPacket(const RayPacket& packet, double* t,
+        std::size_t* element) const override;
     Math::Vector3D getNormal(const Math::Point3D& point) const override;
-    std::unique_ptr<IMaterial> getMaterial() const override;
     bool isPlane() const override;
+    AABB getBoundingBox() const override;
 };
 
 } // namespace Raytracer
@@ -16,19 +16,41 @@
 
 namespace Math {
 
-class Point3D {
+template <typename T>
+class Point3 {
 public:
-    double x;
-    double y;
-    double z;
-
-    Point3D(double x = 0, double y = 0, double z = 0);
-
-    Point3D operator+(const Vector3D& vector) const;
-    Point3D& operator+=(const Vector3D& vector);
-    Vector3D operator-(const Point3D& other) const;
+    T x;
+    T y;
+    T z;
+
+    constexpr Point3(T x = 0, T y = 0, T z = 0)
+        : x(x)
+        , y(y)
+        , z(z)
+    {
+    }
+
+    Point3 operator+(const Vector3<T>& vector) const
+    {
+        return Point3(x + vector.x, y + vector.y, z + vector.z);
+    }
+
+    Point3& operator+=(const Vector3<T>& vector)
+    {
+        x += vector.x;
+        y += vector.y;
+        z += vector.z;
+        return *this;
+    }
+
+    Vector3<T> operator-(const Point3& other) const
+    {
+        return Vector3<T>(x - other.x, y - other.y, z - other.z);
+    }
 };
 
+using Point3D = Point3<Real>;
+
 }
 
 #endif
@@ -0,0 +1,63 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** RayPacket.hpp
+*/
+
+#ifndef RAYTRACER_RAYPACKET_HPP
+#define RAYTRACER_RAYPACKET_HPP
+
+#include "Ray.hpp"
+
+namespace Raytracer {
+
+// Up to SIZE rays stored component by component, so that intersection
+// kernels run the same arithmetic on every lane and the compiler can map
+// the lanes onto vector registers. Lanes past count repeat the last ray:
+// kernels process all SIZE lanes without masking and callers ignore the
+// extra results.
+struct RayPacket {
+    static constexpr int SIZE = 8;
+
+    alignas(32) Math::Real ox[SIZE];
+    alignas(32) Math::Real oy[SIZE];
+    alignas(32) Math::Real oz[SIZE];
+    alignas(32) Math::Real dx[SIZE];
+    alignas(32) Math::Real dy[SIZE];
+    alignas(32) Math::Real dz[SIZE];
+    int count = 0;
+
+    void set(int lane, const Ray& ray)
+    {
+        ox[lane] = ray.origin.x;
+        oy[lane] = ray.origin.y;
+        oz[lane] = ray.origin.z;
+        dx[lane] = ray.direction.x;
+        dy[lane] = ray.direction.y;
+        dz[lane] = ray.direction.z;
+    }
+
+    Ray ray(int lane) const
+    {
+        return Ray(Math::Point3D(ox[lane], oy[lane], oz[lane]),
+            Math::Vector3D(dx[lane], dy[lane], dz[lane]));
+    }
+
+    // Fills the lanes past count with copies of the last active ray
+    void pad()
+    {
+        for (int i = count; i < SIZE && count > 0; i++) {
+            ox[i] = ox[count - 1];
+            oy[i] = oy[count - 1];
+            oz[i] = oz[count - 1];
+            dx[i] = dx[count - 1];
+            dy[i] = dy[count - 1];
+            dz[i] = dz[count - 1];
+        }
+    }
+};
+
+} // namespace Raytracer
+
+#endif /* RAYTRACER_RAYPACKET_HPP */
@@ -52,7 +52,7 @@ Sphere::Sphere(const libconfig::Setting& settings)
         settings.lookupValue("r", r);
 
         center = Math::Point3D(0, 0, 0);
-        position = Math::Vector3D(x, y, z);
+        setPosition(Math::Vector3D(x, y, z));
         radius = r;
 
         // Use the base class method to load material
@@ -69,17 +69,17 @@ Sphere::Sphere(const libconfig::Setting& settings)
 double Sphere::localHits(const Ray& localRay) const
 {
     Math::Vector3D oc = localRay.origin - center;
-    double a = localRay.direction.dot(localRay.direction);
-    double b = 2.0 * oc.dot(localRay.direction);
-    double c = oc.dot(oc) - radius * radius;
+    Math::Real a = localRay.direction.dot(localRay.direction);
+    Math::Real b = 2 * oc.dot(localRay.direction);
+    Math::Real c = oc.dot(oc) - radius * radius;
 
-    double discriminant = b * b - 4 * a * c;
+    Math::Real discriminant = b * b - 4 * a * c;
 
     if (discriminant < 0) {
         return -1;
     } else {
-        double t1 = (-b - std::sqrt(discriminant)) / (2.0 * a);
-        double t2 = (-b + std::sqrt(discriminant)) / (2.0 * a);
+        Math::Real t1 = (-b - std::sqrt(discriminant)) / (2 * a);
+        Math::Real t2 = (-b + std::sqrt(discriminant)) / (2 * a);
 
         if (t1 > 0)
             return t1;
@@ -90,6 +90,29 @@ double Sphere::localHits(const Ray& localRay) const
     }
 }
 
+// Same arithmetic as localHits, with the branches turned into selects so
+// that every lane runs the same instructions
+void Sphere::localHitsPacket(const RayPacket& packet, double* t) const
+{
+    for (int i = 0; i < RayPacket::SIZE; i++) {
+        Math::Real ocx = packet.ox[i] - center.x;
+        Math::Real ocy = packet.oy[i] - center.y;
+        Math::Real ocz = packet.oz[i] - center.z;
+        Math::Real a = packet.dx[i] * packet.dx[i] + packet.dy[i] * packet.dy[i]
+            + packet.dz[i] * packet.dz[i];
+        Math::Real b = 2 * (ocx * packet.dx[i] + ocy * packet.dy[i] + ocz * packet.dz[i]);
+        Math::Real c = (ocx * ocx + ocy * ocy + ocz * ocz) - radius * radius;
+
+        Math::Real discriminant = b * b - 4 * a * c;
+        Math::Real root = std::sqrt(discriminant < 0 ? 0 : discriminant);
+        Math::Real t1 = (-b - root) / (2 * a);
+        Math::Real t2 = (-b + root) / (2 * a);
+
+        Math::Real hit = t1 > 0 ? t1 : (t2 > 0 ? t2 : -1);
+        t[i] = discriminant < 0 ? -1 : hit;
+    }
+}
+
 Math::Vector3D Sphere::localGetNormal(const Math::Point3D& localPoint) const
 {
     Math::Vector3D normal(localPoint.x - center.x, localPoint.y - center.y,
@@ -99,6 +122,12 @@ Math::Vector3D Sphere::localGetNormal(const Math::Point3D& localPoint) const
         normal.z / length);
 }
 
+AABB Sphere::localBoundingBox() const
+{
+    return AABB(Math::Point3D(center.x - radius, center.y - radius, center.z - radius),
+        Math::Point3D(center.x + radius, center.y + radius, center.z + radius));
+}
+
 bool Sphere::isPlane() const { return false; }
 
 } // namespace Raytracer
@@ -0,0 +1,113 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** Transform.hpp
+*/
+
+#ifndef RAYTRACER_TRANSFORM_HPP
+#define RAYTRACER_TRANSFORM_HPP
+
+#include "AABB.hpp"
+#include "Point3D.hpp"
+#include "Vector3D.hpp"
+#include <cmath>
+
+namespace Raytracer {
+
+// Rigid transform baked into a rotation matrix and an offset: a point is
+// rotated about the origin, then moved by the offset. Rotations are
+// orthonormal, so ray directions keep their length and hit distances are
+// the same in both spaces.
+class Transform {
+public:
+    Transform() = default;
+
+    // Euler angles in radians, applied Z first, then Y, then X
+    Transform(const Math::Vector3D& rotation, const Math::Vector3D& offset)
+        : _offset(offset)
+    {
+        double cosX = std::cos(rotation.x), sinX = std::sin(rotation.x);
+        double cosY = std::cos(rotation.y), sinY = std::sin(rotation.y);
+        double cosZ = std::cos(rotation.z), sinZ = std::sin(rotation.z);
+
+        _rows[0] = Math::Vector3D(cosY * cosZ, -cosY * sinZ, sinY);
+        _rows[1] = Math::Vector3D(sinX * sinY * cosZ + cosX * sinZ,
+            -sinX * sinY * sinZ + cosX * cosZ, -sinX * cosY);
+        _rows[2] = Math::Vector3D(-cosX * sinY * cosZ + sinX * sinZ,
+            cosX * sinY * sinZ + sinX * cosZ, cosX * cosY);
+
+        // The inverse of a rotation is its transpose
+        _inverseRows[0] = Math::Vector3D(_rows[0].x, _rows[1].x, _rows[2].x);
+        _inverseRows[1] = Math::Vector3D(_rows[0].y, _rows[1].y, _rows[2].y);
+        _inverseRows[2] = Math::Vector3D(_rows[0].z, _rows[1].z, _rows[2].z);
+
+        _rotated = rotation.x != 0 || rotation.y != 0 || rotation.z != 0;
+        _identity = !_rotated && offset.x == 0 && offset.y == 0 && offset.z == 0;
+    }
+
+    bool isIdentity() const { return _identity; }
+    bool isRotated() const { return _rotated; }
+    const Math::Vector3D& getOffset() const { return _offset; }
+
+    Math::Vector3D rotate(const Math::Vector3D& vec) const
+    {
+        if (!_rotated)
+            return vec;
+        return Math::Vector3D(_rows[0].dot(vec), _rows[1].dot(vec), _rows[2].dot(vec));
+    }
+
+    Math::Vector3D inverseRotate(const Math::Vector3D& vec) const
+    {
+        if (!_rotated)
+            return vec;
+        return Math::Vector3D(_inverseRows[0].dot(vec), _inverseRows[1].dot(vec),
+            _inverseRows[2].dot(vec));
+    }
+
+    Math::Point3D apply(const Math::Point3D& point) const
+    {
+        if (_identity)
+            return point;
+        Math::Vector3D rotated = rotate(Math::Vector3D(point.x, point.y, point.z));
+        return Math::Point3D(rotated.x, rotated.y, rotated.z) + _offset;
+    }
+
+    Math::Point3D inverse(const Math::Point3D& point) const
+    {
+        if (_identity)
+            return point;
+        Math::Point3D moved = point + (-_offset);
+        Math::Vector3D rotated = inverseRotate(Math::Vector3D(moved.x, moved.y, moved.z));
+        return Math::Point3D(rotated.x, rotated.y, rotated.z);
+    }
+
+    // Box holding the 8 transformed corners of box, which is no longer
+    // axis aligned once rotated
+    AABB apply(const AABB& box) const
+    {
+        if (_identity)
+            return box;
+        AABB result;
+        for (int i = 0; i < 8; i++) {
+            Math::Point3D corner((i & 1) ? box.max.x : box.min.x,
+                (i & 2) ? box.max.y : box.min.y,
+                (i & 4) ? box.max.z : box.min.z);
+            result.expand(apply(corner));
+        }
+        return result;
+    }
+
+private:
+    Math::Vector3D _rows[3] = { Math::Vector3D(1, 0, 0), Math::Vector3D(0, 1, 0),
+        Math::Vector3D(0, 0, 1) };
+    Math::Vector3D _inverseRows[3] = { Math::Vector3D(1, 0, 0), Math::Vector3D(0, 1, 0),
+        Math::Vector3D(0, 0, 1) };
+    Math::Vector3D _offset = Math::Vector3D(0, 0, 0);
+    bool _rotated = false;
+    bool _identity = true;
+};
+
+} // namespace Raytracer
+
+#endif /* RAYTRACER_TRANSFORM_HPP */
@@ -18,6 +18,7 @@
  */
 
 #include "Triangle.hpp"
+#include "WatertightTriangle.hpp"
 #include "../utils/Debug.hpp"
 #include <iostream>
 
@@ -29,6 +30,7 @@ Triangle::Triangle(const Math::Point3D &v1, const Math::Point3D &v2,
   if (material) {
     this->material = std::move(material);
   }
+  normal = (v2 - v1).cross(v3 - v1).normalize();
 }
 
 Triangle::Triangle(const libconfig::Setting &settings) : ATransformable() {
@@ -61,7 +63,7 @@ Triangle::Triangle(const libconfig::Setting &settings) : ATransformable() {
                            (w1.y + w2.y + w3.y) / 3.0,
                            (w1.z + w2.z + w3.z) / 3.0);
 
-    position = Math::Vector3D(centroid.x, centroid.y, centroid.z);
+    setPosition(Math::Vector3D(centroid.x, centroid.y, centroid.z));
 
     v1 = Math::Point3D(w1.x - centroid.x, w1.y - centroid.y, w1.z - centroid.z);
     v2 = Math::Point3D(w2.x - centroid.x, w2.y - centroid.y, w2.z - centroid.z);
@@ -69,57 +71,48 @@ Triangle::Triangle(const libconfig::Setting &settings) : ATransformable() {
 
     loadMaterial(settings);
     loadTransforms(settings);
+    bakeTransforms();
   } catch (const libconfig::SettingException &ex) {
     Debug::log("Error loading triangle: ", ex.what());
     throw;
   }
 }
 
-double Triangle::localHits(const Ray &ray) const {
-  const double EPSILON = 0.0000001;
-
-  Math::Vector3D edge1 = v2 - v1;
-  Math::Vector3D edge2 = v3 - v1;
-
-  Math::Vector3D pvec = ray.direction.cross(edge2);
-
-  double det = edge1.dot(pvec);
-  if (std::abs(det) < EPSILON)
-    return -1;
-
-  double invDet = 1.0 / det;
-
-  Math::Vector3D tvec = ray.origin - v1;
-
-  double u = tvec.dot(pvec) * invDet;
-  if (u < 0.0 || u > 1.0)
-    return -1;
-
-  Math::Vector3D qvec = tvec.cross(edge1);
-
-  double v = ray.direction.dot(qvec) * invDet;
-  if (v < 0.0 || u + v > 1.0)
-    return -1;
+void Triangle::bakeTransforms() {
+  // Triangles are flat: moving their vertices is exact, and a ray no longer
+  // has to be brought into local space on every test
+  v1 = applyTransforms(v1);
+  v2 = applyTransforms(v2);
+  v3 = applyTransforms(v3);
+  translation = Math::Vector3D(0, 0, 0);
+  rotation = Math::Vector3D(0, 0, 0);
+  position = Math::Vector3D(0, 0, 0);
+  updateTransform();
+
+  normal = (v2 - v1).cross(v3 - v1).normalize();
+}
 
-  double t = edge2.dot(qvec) * invDet;
+double Triangle::localHits(const Ray &ray) const {
+  return Watertight::intersect(WatertightRay(ray), v1, v2, v3);
+}
 
-  return t > EPSILON ? t : -1;
+void Triangle::localHitsPacket(const RayPacket &packet, double *t) const {
+  for (int i = 0; i < RayPacket::SIZE; i++)
+    t[i] = Watertight::intersect(WatertightRay(packet.ray(i)), v1, v2, v3);
 }
 
 Math::Vector3D Triangle::localGetNormal(const Math::Point3D &) const {
-  Math::Vector3D edge1 = v2 - v1;
-  Math::Vector3D edge2 = v3 - v1;
-  Math::Vector3D normal = edge1.cross(edge2);
-
-  double length = normal.length();
-  if (length > 0) {
-    normal =
-        Math::Vector3D(normal.x / length, normal.y / length, normal.z / length);
-  }
-
   return normal;
 }
 
+AABB Triangle::localBoundingBox() const {
+  AABB box;
+  box.expand(v1);
+  box.expand(v2);
+  box.expand(v3);
+  return box;
+}
+
 bool Triangle::isPlane() const { return false; }
 
 } // namespace Raytracer
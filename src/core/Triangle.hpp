@@ -33,8 +33,17 @@ public:
     Triangle(const libconfig::Setting& settings);
 
 protected:
+    // Unit normal following the vertex winding, computed once
+    Math::Vector3D normal;
+
+    // Moves the vertices to world space and drops the transform, done once
+    // at load time
+    void bakeTransforms();
+
     double localHits(const Ray& ray) const override;
+    void localHitsPacket(const RayPacket& packet, double* t) const override;
     Math::Vector3D localGetNormal(const Math::Point3D& point) const override;
+    AABB localBoundingBox() const override;
 
 public:
     bool isPlane() const override;
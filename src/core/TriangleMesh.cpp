@@ -0,0 +1,91 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** TriangleMesh.cpp
+*/
+
+#include "TriangleMesh.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace Raytracer {
+
+TriangleMesh::TriangleMesh(std::shared_ptr<const MeshData> mesh,
+    std::unique_ptr<IMaterial> material, const Transform& transform)
+    : mesh(std::move(mesh))
+    , transform(transform)
+{
+    if (!this->mesh)
+        throw std::invalid_argument("TriangleMesh needs mesh data");
+    if (material)
+        this->material = std::move(material);
+}
+
+Ray TriangleMesh::toMesh(const Ray& ray) const
+{
+    return Ray(transform.inverse(ray.origin), transform.inverseRotate(ray.direction));
+}
+
+double TriangleMesh::hits(const Ray& ray) const
+{
+    std::size_t triangle;
+    return mesh->intersect(toMesh(ray), triangle);
+}
+
+double TriangleMesh::hitsElement(const Ray& ray, std::size_t& element) const
+{
+    return mesh->intersect(toMesh(ray), element);
+}
+
+void TriangleMesh::hitsPacket(const RayPacket& packet, double* t,
+    std::size_t* element) const
+{
+    RayPacket local = packet;
+    if (transform.isRotated()) {
+        for (int i = 0; i < RayPacket::SIZE; i++)
+            local.set(i, toMesh(packet.ray(i)));
+    } else {
+        const Math::Vector3D& offset = transform.getOffset();
+        for (int i = 0; i < RayPacket::SIZE; i++) {
+            local.ox[i] -= offset.x;
+            local.oy[i] -= offset.y;
+            local.oz[i] -= offset.z;
+        }
+    }
+    mesh->intersectPacket(local, t, element);
+}
+
+Math::Vector3D TriangleMesh::getNormal(const Math::Point3D& point) const
+{
+    Math::Point3D local = transform.inverse(point);
+    return transform.rotate(mesh->getNormal(mesh->findTriangle(local), local));
+}
+
+Math::Vector3D TriangleMesh::getElementNormal(const Math::Point3D& point,
+    std::size_t element) const
+{
+    return transform.rotate(mesh->getNormal(element, transform.inverse(point)));
+}
+
+bool TriangleMesh::isPlane() const
+{
+    return false;
+}
+
+AABB TriangleMesh::getBoundingBox() const
+{
+    // Widened by a few ulps of its largest coordinate, so that the rounding
+    // of the transform never leaves a face outside of the box
+    const AABB bounds = transform.apply(mesh->getBounds());
+    Math::Real extent = std::max({ std::abs(bounds.min.x), std::abs(bounds.min.y),
+        std::abs(bounds.min.z), std::abs(bounds.max.x), std::abs(bounds.max.y),
+        std::abs(bounds.max.z) });
+    Math::Real margin = 8 * std::numeric_limits<Math::Real>::epsilon() * extent;
+    Math::Vector3D pad(margin, margin, margin);
+    return AABB(bounds.min + (-pad), bounds.max + pad);
+}
+
+} // namespace Raytracer
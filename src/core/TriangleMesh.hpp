@@ -0,0 +1,50 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** TriangleMesh.hpp
+*/
+
+#ifndef RAYTRACER_TRIANGLEMESH_HPP
+#define RAYTRACER_TRIANGLEMESH_HPP
+
+#include "../interfaces/APrimitive.hpp"
+#include "MeshData.hpp"
+#include "Transform.hpp"
+#include <memory>
+
+namespace Raytracer {
+
+// One placement of an OBJ object, as a single primitive with one material
+// for every face. The geometry and its BVH stay in a MeshData shared by
+// every instance of the file, in the coordinates of the file; rays are
+// moved into them by the inverse of the instance transform. The scene BVH
+// over instances is the top level above the per-mesh trees.
+class TriangleMesh : public APrimitive {
+public:
+    TriangleMesh(std::shared_ptr<const MeshData> mesh,
+        std::unique_ptr<IMaterial> material = nullptr,
+        const Transform& transform = Transform());
+
+    double hits(const Ray& ray) const override;
+    double hitsElement(const Ray& ray, std::size_t& element) const override;
+    void hitsPacket(const RayPacket& packet, double* t,
+        std::size_t* element) const override;
+    Math::Vector3D getNormal(const Math::Point3D& point) const override;
+    Math::Vector3D getElementNormal(const Math::Point3D& point,
+        std::size_t element) const override;
+    bool isPlane() const override;
+    AABB getBoundingBox() const override;
+
+    const MeshData& getMesh() const { return *mesh; }
+
+private:
+    Ray toMesh(const Ray& ray) const;
+
+    std::shared_ptr<const MeshData> mesh;
+    Transform transform;
+};
+
+} // namespace Raytracer
+
+#endif /* RAYTRACER_TRIANGLEMESH_HPP */
@@ -16,35 +16,137 @@
 
 namespace Math {
 
-class Vector3D {
+// Scalar type of the geometry, double unless the renderer is built with
+// RAYTRACER_USE_FLOAT (make float)
+#ifdef RAYTRACER_USE_FLOAT
+using Real = float;
+#else
+using Real = double;
+#endif
+
+// Header-only so that every operator inlines at its call site, where the
+// compiler can keep the components in registers and pack the three lanes
+// into vector instructions
+template <typename T>
+class Vector3 {
 public:
-    double x;
-    double y;
-    double z;
-
-    Vector3D(double x = 0, double y = 0, double z = 0);
-
-    double length() const;
-    double dot(const Vector3D& other) const;
-    Vector3D cross(const Vector3D& other) const;
-    Vector3D normalize() const;
-
-    Vector3D operator+(const Vector3D& other) const;
-    Vector3D& operator+=(const Vector3D& other);
-    Vector3D operator-(const Vector3D& other) const;
-    Vector3D& operator-=(const Vector3D& other);
-    Vector3D operator*(const Vector3D& other) const;
-    Vector3D& operator*=(const Vector3D& other);
-    Vector3D operator/(const Vector3D& other) const;
-    Vector3D& operator/=(const Vector3D& other);
-
-    Vector3D operator*(double scalar) const;
-    Vector3D& operator*=(double scalar);
-    Vector3D operator/(double scalar) const;
-    Vector3D& operator/=(double scalar);
-    Vector3D operator-() const;
+    T x;
+    T y;
+    T z;
+
+    constexpr Vector3(T x = 0, T y = 0, T z = 0)
+        : x(x)
+        , y(y)
+        , z(z)
+    {
+    }
+
+    T length() const { return std::sqrt(dot(*this)); }
+
+    T dot(const Vector3& other) const
+    {
+        return x * other.x + y * other.y + z * other.z;
+    }
+
+    Vector3 cross(const Vector3& other) const
+    {
+        return Vector3(
+            y * other.z - z * other.y,
+            z * other.x - x * other.z,
+            x * other.y - y * other.x);
+    }
+
+    Vector3 normalize() const
+    {
+        T len = length();
+        if (len == 0)
+            return Vector3(0, 0, 0);
+        return Vector3(x / len, y / len, z / len);
+    }
+
+    Vector3 operator+(const Vector3& other) const
+    {
+        return Vector3(x + other.x, y + other.y, z + other.z);
+    }
+
+    Vector3& operator+=(const Vector3& other)
+    {
+        x += other.x;
+        y += other.y;
+        z += other.z;
+        return *this;
+    }
+
+    Vector3 operator-(const Vector3& other) const
+    {
+        return Vector3(x - other.x, y - other.y, z - other.z);
+    }
+
+    Vector3& operator-=(const Vector3& other)
+    {
+        x -= other.x;
+        y -= other.y;
+        z -= other.z;
+        return *this;
+    }
+
+    Vector3 operator*(const Vector3& other) const
+    {
+        return Vector3(x * other.x, y * other.y, z * other.z);
+    }
+
+    Vector3& operator*=(const Vector3& other)
+    {
+        x *= other.x;
+        y *= other.y;
+        z *= other.z;
+        return *this;
+    }
+
+    Vector3 operator/(const Vector3& other) const
+    {
+        return Vector3(x / other.x, y / other.y, z / other.z);
+    }
+
+    Vector3& operator/=(const Vector3& other)
+    {
+        x /= other.x;
+        y /= other.y;
+        z /= other.z;
+        return *this;
+    }
+
+    Vector3 operator*(T scalar) const
+    {
+        return Vector3(x * scalar, y * scalar, z * scalar);
+    }
+
+    Vector3& operator*=(T scalar)
+    {
+        x *= scalar;
+        y *= scalar;
+        z *= scalar;
+        return *this;
+    }
+
+    Vector3 operator/(T scalar) const
+    {
+        return Vector3(x / scalar, y / scalar, z / scalar);
+    }
+
+    Vector3& operator/=(T scalar)
+    {
+        x /= scalar;
+        y /= scalar;
+        z /= scalar;
+        return *this;
+    }
+
+    Vector3 operator-() const { return Vector3(-x, -y, -z); }
 };
 
+using Vector3D = Vector3<Real>;
+
 } // namespace Math
 
 #endif
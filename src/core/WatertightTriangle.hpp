@@ -0,0 +1,165 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** WatertightTriangle.hpp
+*/
+
+#ifndef RAYTRACER_WATERTIGHTTRIANGLE_HPP
+#define RAYTRACER_WATERTIGHTTRIANGLE_HPP
+
+#include "Point3D.hpp"
+#include "Ray.hpp"
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+namespace Raytracer {
+
+// Watertight ray/triangle test (Woop, Benthin and Wald, JCGT 2013). The ray
+// is turned into a shear that maps it onto the +z axis, then the three
+// edge functions are evaluated in 2D. Two triangles sharing an edge compute
+// that edge's function from the same two vertices with the same
+// operations, so a ray through the edge cannot miss both of them.
+struct WatertightRay {
+    int kx = 0;
+    int ky = 1;
+    int kz = 2;
+    Math::Real sx = 0;
+    Math::Real sy = 0;
+    Math::Real sz = 1;
+    Math::Point3D origin;
+
+    WatertightRay() = default;
+
+    explicit WatertightRay(const Ray& ray)
+        : origin(ray.origin)
+    {
+        const Math::Real dir[3] = { ray.direction.x, ray.direction.y, ray.direction.z };
+
+        // Shear along the dominant axis, swapping the other two when it
+        // points backwards to keep the triangle winding
+        kz = std::abs(dir[0]) > std::abs(dir[1])
+            ? (std::abs(dir[0]) > std::abs(dir[2]) ? 0 : 2)
+            : (std::abs(dir[1]) > std::abs(dir[2]) ? 1 : 2);
+        kx = (kz + 1) % 3;
+        ky = (kx + 1) % 3;
+        if (dir[kz] < 0)
+            std::swap(kx, ky);
+
+        sx = dir[kx] / dir[kz];
+        sy = dir[ky] / dir[kz];
+        sz = 1 / dir[kz];
+    }
+};
+
+// Up to WIDTH triangles stored vertex by vertex and component by component,
+// tested against one ray in a single loop. Vertices are kept in the float
+// precision meshes are loaded with. Unused slots are left degenerate and
+// never hit.
+struct TriangleBlock {
+    static constexpr int WIDTH = 4;
+
+    alignas(16) float ax[WIDTH];
+    alignas(16) float ay[WIDTH];
+    alignas(16) float az[WIDTH];
+    alignas(16) float bx[WIDTH];
+    alignas(16) float by[WIDTH];
+    alignas(16) float bz[WIDTH];
+    alignas(16) float cx[WIDTH];
+    alignas(16) float cy[WIDTH];
+    alignas(16) float cz[WIDTH];
+};
+
+namespace Watertight {
+
+    // Hits closer than this are rejected, as the Moller-Trumbore test did
+    constexpr double EPSILON = 0.0000001;
+
+    // Distance along the ray from the 2D edge functions, -1 on a miss
+    inline double distance(Math::Real u, Math::Real v, Math::Real w,
+        Math::Real az, Math::Real bz, Math::Real cz)
+    {
+        // Bitwise operators keep the test free of branches so that the
+        // block loop vectorizes
+        bool negative = (u < 0) | (v < 0) | (w < 0);
+        bool positive = (u > 0) | (v > 0) | (w > 0);
+        Math::Real det = u + v + w;
+        Math::Real t = (u * az + v * bz + w * cz) / det;
+        bool miss = (negative & positive) | (det == 0) | !(t > EPSILON);
+        return miss ? -1.0 : t;
+    }
+
+    // Edge functions of a vertex pair, in double when the geometry runs in
+    // float and the float result is too close to zero to trust its sign
+    inline Math::Real edge(Math::Real px, Math::Real py, Math::Real qx,
+        Math::Real qy)
+    {
+        Math::Real e = px * qy - py * qx;
+        if constexpr (!std::is_same_v<Math::Real, double>) {
+            if (e == 0)
+                e = static_cast<Math::Real>(static_cast<double>(px) * qy - static_cast<double>(py) * qx);
+        }
+        return e;
+    }
+
+    inline double intersect(const WatertightRay& ray, const Math::Point3D& a,
+        const Math::Point3D& b, const Math::Point3D& c)
+    {
+        const Math::Real pa[3] = { a.x - ray.origin.x, a.y - ray.origin.y, a.z - ray.origin.z };
+        const Math::Real pb[3] = { b.x - ray.origin.x, b.y - ray.origin.y, b.z - ray.origin.z };
+        const Math::Real pc[3] = { c.x - ray.origin.x, c.y - ray.origin.y, c.z - ray.origin.z };
+
+        Math::Real ax = pa[ray.kx] - ray.sx * pa[ray.kz];
+        Math::Real ay = pa[ray.ky] - ray.sy * pa[ray.kz];
+        Math::Real bx = pb[ray.kx] - ray.sx * pb[ray.kz];
+        Math::Real by = pb[ray.ky] - ray.sy * pb[ray.kz];
+        Math::Real cx = pc[ray.kx] - ray.sx * pc[ray.kz];
+        Math::Real cy = pc[ray.ky] - ray.sy * pc[ray.kz];
+
+        return distance(edge(cx, cy, bx, by), edge(ax, ay, cx, cy),
+            edge(bx, by, ax, ay), ray.sz * pa[ray.kz], ray.sz * pb[ray.kz],
+            ray.sz * pc[ray.kz]);
+    }
+
+    // intersect() for every slot of a block, t receives WIDTH distances
+    inline void intersect(const WatertightRay& ray, const TriangleBlock& block,
+        double* t)
+    {
+        constexpr int W = TriangleBlock::WIDTH;
+        const float* a[3] = { block.ax, block.ay, block.az };
+        const float* b[3] = { block.bx, block.by, block.bz };
+        const float* c[3] = { block.cx, block.cy, block.cz };
+        const Math::Real o[3] = { ray.origin.x, ray.origin.y, ray.origin.z };
+        const float *akx = a[ray.kx], *aky = a[ray.ky], *akz = a[ray.kz];
+        const float *bkx = b[ray.kx], *bky = b[ray.ky], *bkz = b[ray.kz];
+        const float *ckx = c[ray.kx], *cky = c[ray.ky], *ckz = c[ray.kz];
+        const Math::Real ox = o[ray.kx], oy = o[ray.ky], oz = o[ray.kz];
+
+        // Same operations as the single triangle test, one lane per slot.
+        // Results go to a local array: storing through t could alias the
+        // block and would keep the loop from vectorizing.
+        alignas(32) double result[W];
+        for (int i = 0; i < W; i++) {
+            Math::Real az = akz[i] - oz;
+            Math::Real bz = bkz[i] - oz;
+            Math::Real cz = ckz[i] - oz;
+            Math::Real ax = (akx[i] - ox) - ray.sx * az;
+            Math::Real ay = (aky[i] - oy) - ray.sy * az;
+            Math::Real bx = (bkx[i] - ox) - ray.sx * bz;
+            Math::Real by = (bky[i] - oy) - ray.sy * bz;
+            Math::Real cx = (ckx[i] - ox) - ray.sx * cz;
+            Math::Real cy = (cky[i] - oy) - ray.sy * cz;
+
+            result[i] = distance(edge(cx, cy, bx, by), edge(ax, ay, cx, cy),
+                edge(bx, by, ax, ay), ray.sz * az, ray.sz * bz, ray.sz * cz);
+        }
+        for (int i = 0; i < W; i++)
+            t[i] = result[i];
+    }
+
+} // namespace Watertight
+
+} // namespace Raytracer
+
+#endif /* RAYTRACER_WATERTIGHTTRIANGLE_HPP */
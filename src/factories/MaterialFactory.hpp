@@ -50,6 +50,9 @@ public:
 
     static std::unique_ptr<IMaterial> createDefaultMaterial();
 
+    // Single default instance shared by every primitive without a material
+    static std::shared_ptr<const IMaterial> getDefaultMaterial();
+
     static std::unique_ptr<CompositeMaterial> createCompositeMaterial(const Math::Vector3D& color = Math::Vector3D(1.0, 1.0, 1.0))
     {
         return std::make_unique<CompositeMaterial>(color);
@@ -82,6 +85,12 @@ inline std::unique_ptr<IMaterial> MaterialFactory::createDefaultMaterial()
     return std::make_unique<MatteMaterial>(Math::Vector3D(1.0, 0.0, 0.0));
 }
 
+inline std::shared_ptr<const IMaterial> MaterialFactory::getDefaultMaterial()
+{
+    static const std::shared_ptr<const IMaterial> defaultMaterial = createDefaultMaterial();
+    return defaultMaterial;
+}
+
 inline void MaterialFactory::registerAllMaterials()
 {
     Debug::log("Registering all material types");
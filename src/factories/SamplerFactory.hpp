@@ -0,0 +1,80 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** SamplerFactory.hpp
+*/
+#ifndef RAYTRACER_SAMPLERFACTORY_HPP_
+#define RAYTRACER_SAMPLERFACTORY_HPP_
+
+#include "../interfaces/ISampler.hpp"
+#include "../sampler/HaltonSampler.hpp"
+#include "../sampler/RandomSampler.hpp"
+#include "../sampler/SobolSampler.hpp"
+#include "../sampler/StratifiedSampler.hpp"
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Raytracer {
+
+class SamplerFactory {
+public:
+    // Samplers are built per render, they may need the pixel sample count
+    using Creator = std::function<std::unique_ptr<ISampler>(int samplesPerPixel, std::uint64_t seed)>;
+
+    static void registerAllSamplers();
+
+    template <typename T>
+    static void registerType(const std::string& type);
+
+    static std::unique_ptr<ISampler> createSampler(const std::string& type, int samplesPerPixel, std::uint64_t seed = 0);
+
+    static std::vector<std::string> getRegisteredTypes()
+    {
+        std::vector<std::string> types;
+        for (const auto& [type, _] : creators) {
+            types.push_back(type);
+        }
+        return types;
+    }
+
+private:
+    static std::map<std::string, Creator> creators;
+};
+
+inline std::map<std::string, SamplerFactory::Creator> SamplerFactory::creators;
+
+template <typename T>
+void SamplerFactory::registerType(const std::string& type)
+{
+    creators[type] = [](int, std::uint64_t seed) {
+        return std::make_unique<T>(seed);
+    };
+}
+
+inline std::unique_ptr<ISampler> SamplerFactory::createSampler(const std::string& type, int samplesPerPixel, std::uint64_t seed)
+{
+    auto it = creators.find(type);
+    if (it == creators.end())
+        throw std::runtime_error("Unknown sampler type: " + type);
+    return it->second(samplesPerPixel, seed);
+}
+
+inline void SamplerFactory::registerAllSamplers()
+{
+    registerType<RandomSampler>("random");
+    registerType<HaltonSampler>("halton");
+    registerType<SobolSampler>("sobol");
+    creators["stratified"] = [](int samplesPerPixel, std::uint64_t seed) {
+        return std::make_unique<StratifiedSampler>(samplesPerPixel, seed);
+    };
+}
+
+} // namespace Raytracer
+
+#endif /* RAYTRACER_SAMPLERFACTORY_HPP_ */
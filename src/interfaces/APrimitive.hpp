@@ -29,17 +29,16 @@ namespace Raytracer {
 
 class APrimitive : public IPrimitive {
 protected:
-    std::unique_ptr<IMaterial> material;
+    // Materials are immutable once loaded, so copies of a primitive and
+    // every face of a mesh share one instance instead of cloning it
+    std::shared_ptr<const IMaterial> material;
 
     APrimitive()
-        : material(MaterialFactory::createDefaultMaterial())
+        : material(MaterialFactory::getDefaultMaterial())
     {
     }
 
-    APrimitive(const APrimitive& other)
-        : material(other.material ? other.material->clone() : nullptr)
-    {
-    }
+    APrimitive(const APrimitive& other) = default;
 
     void loadMaterial(const libconfig::Setting& settings)
     {
@@ -65,36 +64,25 @@ protected:
                     Math::Vector3D(r / 255.0, g / 255.0, b / 255.0));
             } else {
                 Debug::log("No material or color specified, using default material");
-                material = MaterialFactory::createDefaultMaterial();
+                material = MaterialFactory::getDefaultMaterial();
             }
         } catch (const libconfig::SettingException& ex) {
             Debug::log("Error loading material: ", ex.what());
-            material = MaterialFactory::createDefaultMaterial();
+            material = MaterialFactory::getDefaultMaterial();
         }
     }
 
 public:
     virtual ~APrimitive() = default;
 
-    APrimitive& operator=(const APrimitive& other)
-    {
-        if (this != &other) {
-            material = other.material ? other.material->clone() : nullptr;
-        }
-        return *this;
-    }
+    APrimitive& operator=(const APrimitive& other) = default;
 
-    std::unique_ptr<IMaterial> getMaterial() const override
+    const IMaterial* getMaterial() const override
     {
-        if (material) {
-            auto clonedMaterial = material->clone();
-            Math::Vector3D color = clonedMaterial->getColor();
-            Debug::log("APrimitive returning material with color: (", color.x, ", ", color.y, ", ", color.z, ")");
-            return clonedMaterial;
-        } else {
-            Debug::log("WARNING: APrimitive has no material, using default RED material");
-            return MaterialFactory::createDefaultMaterial();
-        }
+        if (material)
+            return material.get();
+        RT_LOG_DEBUG("WARNING: APrimitive has no material, using default RED material");
+        return MaterialFactory::getDefaultMaterial().get();
     }
 };
 
@@ -22,7 +22,8 @@
 #include "../core/Point3D.hpp"
 #include "../core/Ray.hpp"
 #include "../core/Vector3D.hpp"
-#include <functional>
+#include "ITracer.hpp"
+#include <cstddef>
 
 namespace Raytracer {
 
@@ -31,6 +32,7 @@ struct IntersectionInfo {
     Math::Vector3D normal;
     bool frontFace;
     double t;
+    std::size_t element = 0; // Face index when the primitive is a mesh
 };
 
 class IMaterialInteraction {
@@ -41,9 +43,19 @@ public:
     virtual Math::Vector3D computeInteraction(
         const Ray& incidentRay,
         const IntersectionInfo& intersection,
-        std::function<Math::Vector3D(const Ray&, int)> traceFunc,
+        ITracer& tracer,
         int depth) const
         = 0;
+
+    // True when computeInteraction returns a constant color plus the colors
+    // from tracer.trace, each multiplied by the weight passed with its ray.
+    // The wavefront engine then shades a hit before its secondary rays are
+    // traced and adds their colors later; other materials are shaded depth
+    // first.
+    virtual bool isLinear() const
+    {
+        return true;
+    }
 };
 
 } // namespace Raytracer
@@ -20,10 +20,13 @@
 #ifndef RAYTRACER_IPRIMITIVE_HPP_
 #define RAYTRACER_IPRIMITIVE_HPP_
 
+#include "../core/AABB.hpp"
 #include "../core/Point3D.hpp"
 #include "../core/Ray.hpp"
+#include "../core/RayPacket.hpp"
 #include "../core/Vector3D.hpp"
 #include "../material/IMaterial.hpp"
+#include <cstddef>
 #include <memory>
 
 namespace Raytracer {
@@ -35,8 +38,38 @@ public:
     virtual ~IPrimitive() = default;
     virtual double hits(const Ray& ray) const = 0;
     virtual Math::Vector3D getNormal(const Math::Point3D& point) const = 0;
-    virtual std::unique_ptr<IMaterial> getMaterial() const = 0;
+    // Shared, immutable material: never null and valid for the primitive's
+    // lifetime, so shading can read it without copying
+    virtual const IMaterial* getMaterial() const = 0;
     virtual bool isPlane() const = 0;
+
+    // World-space bounds; unbounded primitives return AABB::infinite()
+    virtual AABB getBoundingBox() const = 0;
+
+    // Aggregate primitives (meshes) also report which element was hit so the
+    // normal can be looked up without searching for it again
+    virtual double hitsElement(const Ray& ray, std::size_t& element) const
+    {
+        element = 0;
+        return hits(ray);
+    }
+
+    // hitsElement for every lane of a packet, t and element hold
+    // RayPacket::SIZE entries. Primitives with a vectorized kernel override
+    // it; their results must match the single-ray ones.
+    virtual void hitsPacket(const RayPacket& packet, double* t,
+        std::size_t* element) const
+    {
+        for (int i = 0; i < RayPacket::SIZE; i++)
+            t[i] = hitsElement(packet.ray(i), element[i]);
+    }
+
+    virtual Math::Vector3D getElementNormal(const Math::Point3D& point,
+        std::size_t element) const
+    {
+        (void)element;
+        return getNormal(point);
+    }
 };
 
 } // namespace Raytracer
@@ -0,0 +1,46 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** ISampler.hpp
+*/
+#ifndef RAYTRACER_ISAMPLER_HPP_
+#define RAYTRACER_ISAMPLER_HPP_
+
+#include <memory>
+
+namespace Raytracer {
+
+struct Sample2D {
+    double u;
+    double v;
+};
+
+// Source of the random numbers used while tracing one camera sample. A
+// sampler is owned by a single render thread; other threads get a clone.
+class ISampler {
+public:
+    virtual ~ISampler() = default;
+
+    // Restarts the sequence so that the values handed out afterwards only
+    // depend on the pixel, the sample index and the sampler's seed
+    virtual void startSample(int x, int y, int sample) = 0;
+
+    // Each call consumes the next dimension(s) of the sequence, values are
+    // in [0, 1). Two dimensions that are used together, like a position on
+    // the pixel, should come from a single next2D call.
+    virtual double next1D() = 0;
+    virtual Sample2D next2D() = 0;
+
+    // Index of the next dimension. A renderer that shades the bounces of a
+    // sample at different times saves it and resumes the sequence later,
+    // after a startSample call for the same pixel and sample index.
+    virtual int getDimension() const = 0;
+    virtual void setDimension(int dimension) = 0;
+
+    virtual std::unique_ptr<ISampler> clone() const = 0;
+};
+
+} // namespace Raytracer
+
+#endif /* RAYTRACER_ISAMPLER_HPP_ */
@@ -0,0 +1,35 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** ITracer.hpp
+*/
+#ifndef RAYTRACER_ITRACER_HPP_
+#define RAYTRACER_ITRACER_HPP_
+
+#include "../core/Ray.hpp"
+#include "../core/Vector3D.hpp"
+#include "ISampler.hpp"
+
+namespace Raytracer {
+
+// What a material sees of the renderer while shading a hit: a way to
+// follow secondary rays and the random numbers of the current sample.
+// Passed by reference, so a bounce costs one virtual call and nothing is
+// allocated or copied.
+class ITracer {
+public:
+    virtual ~ITracer() = default;
+
+    // Color seen along ray, depth being the number of bounces so far.
+    // weight is the factor the caller applies to the returned color; rays
+    // that would barely contribute to the pixel may be cut short, in which
+    // case the survivors are scaled so that the average stays the same.
+    virtual Math::Vector3D trace(const Ray& ray, int depth, double weight) = 0;
+
+    virtual ISampler& getSampler() = 0;
+};
+
+} // namespace Raytracer
+
+#endif /* RAYTRACER_ITRACER_HPP_ */
@@ -1,5 +1,6 @@
 #include "builders/SceneBuilder.hpp"
 #include "builders/SceneLoader.hpp"
+#include "factories/SamplerFactory.hpp"
 #include "renderer/Renderer.hpp"
 #include "ui/DisplayManager.hpp"
 #include "utils/Debug.hpp"
@@ -12,6 +13,23 @@ static void printUsage(const char *progName) {
   std::cerr << "  -d    Enable debug mode" << std::endl;
   std::cerr << "  -s    Set samples per pixel (default: 1)" << std::endl;
   std::cerr << "  -r    Set maximum ray depth (default: 5)" << std::endl;
+  std::cerr << "  -t    Set render thread count (default: all cores)"
+            << std::endl;
+  std::cerr << "  -a    Stop sampling a pixel once its noise falls below "
+               "this threshold (default: 0, off)"
+            << std::endl;
+  std::cerr << "  -S    Set sampler: stratified, sobol, halton or random "
+               "(default: stratified)"
+            << std::endl;
+  std::cerr << "  --seed  Set the sampler seed (default: 0)" << std::endl;
+  std::cerr << "  -e    Set render engine: recursive or wavefront "
+               "(default: recursive)"
+            << std::endl;
+  std::cerr << "  -o    Set output image file (default: output.ppm)"
+            << std::endl;
+  std::cerr << "  -f    Set output format: ppm, png or pfm (default: from the "
+               "file extension)"
+            << std::endl;
 }
 
 static Raytracer::SceneBuilder loadScene(const std::string &filename) {
@@ -41,6 +59,13 @@ void launchDefault(int argc, char *argv[]) {
   bool debugMode = false;
   int samples = 1;
   int maxDepth = 5;
+  int threads = 0;
+  double adaptiveThreshold = 0.0;
+  std::string samplerType;
+  unsigned long long seed = 0;
+  std::string engine = "recursive";
+  std::string outputPath = "output.ppm";
+  std::string outputFormat;
 
   for (int i = 1; i < argc - 1; i++) {
     std::string arg = argv[i];
@@ -50,14 +75,41 @@ void launchDefault(int argc, char *argv[]) {
       samples = std::stoi(argv[++i]);
     } else if (arg == "-r" && i + 1 < argc - 1) {
       maxDepth = std::stoi(argv[++i]);
+    } else if (arg == "-t" && i + 1 < argc - 1) {
+      threads = std::stoi(argv[++i]);
+    } else if (arg == "-a" && i + 1 < argc - 1) {
+      adaptiveThreshold = std::stod(argv[++i]);
+    } else if (arg == "-S" && i + 1 < argc - 1) {
+      samplerType = argv[++i];
+    } else if (arg == "--seed" && i + 1 < argc - 1) {
+      seed = std::stoull(argv[++i]);
+    } else if (arg == "-e" && i + 1 < argc - 1) {
+      engine = argv[++i];
+    } else if (arg == "-o" && i + 1 < argc - 1) {
+      outputPath = argv[++i];
+    } else if (arg == "-f" && i + 1 < argc - 1) {
+      outputFormat = argv[++i];
     }
   }
 
   Raytracer::Debug::setEnabled(debugMode);
 
   Raytracer::Renderer renderer(loadScene(filename), 1920, 1080, maxDepth,
-                               samples);
+                               samples, threads);
+  renderer.setOutput(outputPath,
+                     outputFormat.empty()
+                         ? Raytracer::ImageWriter::formatFromPath(outputPath)
+                         : Raytracer::ImageWriter::formatFromName(outputFormat));
+  renderer.setAdaptiveThreshold(adaptiveThreshold);
+  renderer.setEngine(Raytracer::Renderer::engineFromName(engine));
+  if (!samplerType.empty() || seed != 0) {
+    Raytracer::SamplerFactory::registerAllSamplers();
+    renderer.setSampler(Raytracer::SamplerFactory::createSampler(
+        samplerType.empty() ? "stratified" : samplerType,
+        renderer.samplesPerPixel(), seed));
+  }
   renderer.render();
+  renderer.save();
 }
 
 int main(int argc, char *argv[]) {
@@ -60,11 +60,11 @@ double AMaterial::getTransparency() const { return 0.0; }
 
 double AMaterial::getRefractionIndex() const { return 1.0; }
 
-Math::Vector3D AMaterial::computeInteraction(const Ray& incidentRay, const IntersectionInfo& intersection, std::function<Math::Vector3D(const Ray&, int)> traceFunc, int depth) const
+Math::Vector3D AMaterial::computeInteraction(const Ray& incidentRay, const IntersectionInfo& intersection, ITracer& tracer, int depth) const
 {
     (void)incidentRay;
     (void)intersection;
-    (void)traceFunc;
+    (void)tracer;
     (void)depth;
 
     return color;
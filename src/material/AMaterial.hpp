@@ -42,7 +42,7 @@ public:
     double getRefractionIndex() const override;
 
     // Base implementation of material interaction
-    Math::Vector3D computeInteraction(const Ray& incidentRay, const IntersectionInfo& intersection, std::function<Math::Vector3D(const Ray&, int)> traceFunc, int depth) const override;
+    Math::Vector3D computeInteraction(const Ray& incidentRay, const IntersectionInfo& intersection, ITracer& tracer, int depth) const override;
 };
 
 } // namespace Raytracer
@@ -23,10 +23,38 @@
 
 namespace Raytracer {
 
+namespace {
+
+    // Tells the tracer about the share of the blend a sub-material's rays
+    // end up with
+    class ScaledTracer : public ITracer {
+    public:
+        ScaledTracer(ITracer& tracer, double scale)
+            : _tracer(tracer)
+            , _scale(scale)
+        {
+        }
+
+        Math::Vector3D trace(const Ray& ray, int depth, double weight) override
+        {
+            return _tracer.trace(ray, depth, weight * _scale);
+        }
+
+        ISampler& getSampler() override { return _tracer.getSampler(); }
+
+    private:
+        ITracer& _tracer;
+        double _scale;
+    };
+
+} // namespace
+
 CompositeMaterial::CompositeMaterial(const libconfig::Setting& settings)
     : AMaterial(settings)
 {
     try {
+        settings.lookupValue("stochastic", stochastic);
+
         if (settings.exists("materials") && settings["materials"].isList()) {
             const libconfig::Setting& materialsList = settings["materials"];
 
@@ -39,6 +67,11 @@ CompositeMaterial::CompositeMaterial(const libconfig::Setting& settings)
                 matEntry.lookupValue("type", type);
                 matEntry.lookupValue("weight", weight);
 
+                if (!(weight > 0.0)) {
+                    Debug::log("Warning: Skipping composite material of type '", type, "' with weight ", weight);
+                    continue;
+                }
+
                 std::unique_ptr<IMaterial> mat = MaterialFactory::createMaterial(type, matEntry);
                 addMaterial(std::move(mat), weight);
 
@@ -55,27 +88,58 @@ CompositeMaterial::CompositeMaterial(const libconfig::Setting& settings)
 Math::Vector3D CompositeMaterial::computeInteraction(
     const Ray& incidentRay,
     const IntersectionInfo& intersection,
-    std::function<Math::Vector3D(const Ray&, int)> traceFunc,
+    ITracer& tracer,
     int depth) const
 {
+    if (stochastic) {
+        // The chosen material's color is already the unbiased estimate:
+        // its weight and its selection probability cancel out
+        const IMaterial* material = pickMaterial(tracer.getSampler().next1D());
+        if (!material)
+            return color;
+        return material->computeInteraction(incidentRay, intersection, tracer, depth);
+    }
 
     Math::Vector3D result(0, 0, 0);
-    double totalWeight = 0.0;
+    double totalWeight = getTotalWeight();
+
+    if (totalWeight <= 0)
+        return color;
 
     for (const auto& [weight, material] : materials) {
+        ScaledTracer scaled(tracer, weight / totalWeight);
         result += material->computeInteraction(
-                      incidentRay, intersection, traceFunc, depth)
+                      incidentRay, intersection, scaled, depth)
             * weight;
-        totalWeight += weight;
     }
 
-    if (totalWeight > 0) {
-        result = result / totalWeight;
-    } else {
-        result = color;
+    return result / totalWeight;
+}
+
+bool CompositeMaterial::isLinear() const
+{
+    for (const auto& [_, material] : materials) {
+        if (!material->isLinear())
+            return false;
     }
+    return true;
+}
+
+const IMaterial* CompositeMaterial::pickMaterial(double u) const
+{
+    double totalWeight = getTotalWeight();
+    if (totalWeight <= 0)
+        return nullptr;
 
-    return result;
+    double target = u * totalWeight;
+    const IMaterial* picked = nullptr;
+    for (const auto& [weight, material] : materials) {
+        picked = material.get();
+        target -= weight;
+        if (target < 0)
+            break;
+    }
+    return picked;
 }
 
 std::unique_ptr<IMaterial> CompositeMaterial::clone() const
@@ -84,6 +148,7 @@ std::unique_ptr<IMaterial> CompositeMaterial::clone() const
     for (const auto& [weight, material] : materials) {
         copy->addMaterial(material->clone(), weight);
     }
+    copy->setStochastic(stochastic);
     return copy;
 }
 
@@ -20,6 +20,7 @@
 
 #include "AMaterial.hpp"
 #include <memory>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
@@ -28,6 +29,10 @@ namespace Raytracer {
 class CompositeMaterial : public AMaterial {
 private:
     std::vector<std::pair<double, std::unique_ptr<IMaterial>>> materials;
+    // Shade with a single sub-material per sample instead of all of them
+    bool stochastic = false;
+
+    const IMaterial* pickMaterial(double u) const;
 
 public:
     CompositeMaterial(const Math::Vector3D& color)
@@ -36,8 +41,11 @@ public:
     }
     CompositeMaterial(const libconfig::Setting& settings);
 
+    // Weights must be positive so the blend and the stochastic pick agree
     void addMaterial(std::unique_ptr<IMaterial> material, double weight)
     {
+        if (!(weight > 0.0))
+            throw std::invalid_argument("Composite material weights must be positive");
         materials.push_back({ weight, std::move(material) });
     }
 
@@ -46,6 +54,19 @@ public:
         materials.clear();
     }
 
+    // Picks one sub-material per sample with probability proportional to
+    // its weight. Each hit then spawns the rays of one material only, and
+    // the average over many samples converges to the weighted blend.
+    void setStochastic(bool enable)
+    {
+        stochastic = enable;
+    }
+
+    bool isStochastic() const
+    {
+        return stochastic;
+    }
+
     size_t getMaterialCount() const
     {
         return materials.size();
@@ -75,7 +96,9 @@ public:
     Math::Vector3D computeInteraction(
         const Ray& incidentRay,
         const IntersectionInfo& intersection,
-        std::function<Math::Vector3D(const Ray&, int)> traceFunc, int depth) const override;
+        ITracer& tracer, int depth) const override;
+
+    bool isLinear() const override;
 
     std::unique_ptr<IMaterial> clone() const override;
 };
@@ -77,7 +77,7 @@ std::unique_ptr<IMaterial> DiamondMaterial::clone() const
 Math::Vector3D DiamondMaterial::computeInteraction(
     const Ray& incidentRay,
     const IntersectionInfo& intersection,
-    std::function<Math::Vector3D(const Ray&, int)> traceFunc,
+    ITracer& tracer,
     int depth) const
 {
 
@@ -103,12 +103,6 @@ Math::Vector3D DiamondMaterial::computeInteraction(
     Math::Vector3D reflectionDir = unit_direction - normal * (2 * unit_direction.dot(normal));
     reflectionDir = reflectionDir.normalize();
 
-    // Create reflection ray
-    Ray reflectionRay(intersection.hitPoint + reflectionDir * 0.001, reflectionDir);
-
-    // Get reflection color
-    Math::Vector3D reflectionColor = traceFunc(reflectionRay, depth + 1);
-
     // Calculate Fresnel effect (Schlick's approximation)
     double r0 = ((etaI - etaT) / (etaI + etaT)) * ((etaI - etaT) / (etaI + etaT));
     double fresnel = r0 + (1 - r0) * pow((1 - cos_theta), 5);
@@ -116,8 +110,17 @@ Math::Vector3D DiamondMaterial::computeInteraction(
     // Increase Fresnel effect to simulate diamond sparkle
     fresnel = std::min(1.0, fresnel * 1.5);
 
+    bool totalInternalReflection = eta_ratio * sin_theta > 1.0;
+
+    // Create reflection ray
+    Ray reflectionRay(intersection.hitPoint + reflectionDir * 0.001, reflectionDir);
+
+    // Get reflection color
+    Math::Vector3D reflectionColor = tracer.trace(reflectionRay, depth + 1,
+        totalInternalReflection ? 1.0 : fresnel * transparency);
+
     // Check for total internal reflection
-    if (eta_ratio * sin_theta > 1.0) {
+    if (totalInternalReflection) {
         // Total internal reflection - use reflection only
         return reflectionColor;
     } else {
@@ -130,7 +133,8 @@ Math::Vector3D DiamondMaterial::computeInteraction(
         Ray refractionRay(intersection.hitPoint + refractionDir * 0.001, refractionDir);
 
         // Get refraction color
-        Math::Vector3D refractionColor = traceFunc(refractionRay, depth + 1);
+        Math::Vector3D refractionColor = tracer.trace(refractionRay, depth + 1,
+            (1.0 - fresnel) * transparency);
 
         // Blend reflection and refraction using Fresnel
         Math::Vector3D resultColor = reflectionColor * fresnel + refractionColor * (1.0 - fresnel);
@@ -141,9 +145,9 @@ Math::Vector3D DiamondMaterial::computeInteraction(
             resultColor.x *= (1.0 + disperseAmount);
             resultColor.z *= (1.0 - disperseAmount * 0.5);
             resultColor = Math::Vector3D(
-                std::min(1.0, resultColor.x),
-                std::min(1.0, resultColor.y),
-                std::min(1.0, resultColor.z));
+                std::min<Math::Real>(1, resultColor.x),
+                std::min<Math::Real>(1, resultColor.y),
+                std::min<Math::Real>(1, resultColor.z));
         }
 
         // Apply color tint
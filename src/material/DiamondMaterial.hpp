@@ -44,8 +44,15 @@ public:
     Math::Vector3D computeInteraction(
         const Ray& incidentRay,
         const IntersectionInfo& intersection,
-        std::function<Math::Vector3D(const Ray&, int)> traceFunc,
+        ITracer& tracer,
         int depth) const override;
+
+    // The dispersion tint scales channels of the traced colors and clamps
+    // them, so diamonds are always shaded depth first
+    bool isLinear() const override
+    {
+        return false;
+    }
 };
 
 } // namespace Raytracer
@@ -88,19 +88,14 @@ double GlassMaterial::schlickFresnelApproximation(double cosTheta, double n1, do
 Math::Vector3D GlassMaterial::computeInteraction(
     const Ray& incidentRay,
     const IntersectionInfo& intersection,
-    std::function<Math::Vector3D(const Ray&, int)> traceFunc,
+    ITracer& tracer,
     int depth) const
 {
-    Debug::log("===== Glass material interaction =====");
-    Debug::log("Material color: (", color.x, ", ", color.y, ", ", color.z, ")");
-    Debug::log("Transparency: ", transparency, ", Refractive index: ", refractionIndex);
-    Debug::log("Intersection at: (", intersection.hitPoint.x, ", ", intersection.hitPoint.y, ", ", intersection.hitPoint.z, ")");
-    Debug::log("Current depth: ", depth);
-
-    if (depth >= 4) {
-        Debug::log("Max depth reached, returning base color");
-        return color;
-    }
+    RT_LOG_TRACE("===== Glass material interaction =====");
+    RT_LOG_TRACE("Material color: (", color.x, ", ", color.y, ", ", color.z, ")");
+    RT_LOG_TRACE("Transparency: ", transparency, ", Refractive index: ", refractionIndex);
+    RT_LOG_TRACE("Intersection at: (", intersection.hitPoint.x, ", ", intersection.hitPoint.y, ", ", intersection.hitPoint.z, ")");
+    RT_LOG_TRACE("Current depth: ", depth);
 
     // Normalize incident direction
     Math::Vector3D unit_direction = incidentRay.direction.normalize();
@@ -108,9 +103,9 @@ Math::Vector3D GlassMaterial::computeInteraction(
 
     // Determine which side we're hitting from
     bool entering = intersection.frontFace;
-    Debug::log("Entering material: ", entering ? "yes" : "no");
-    Debug::log("Normal: (", normal.x, ", ", normal.y, ", ", normal.z, ")");
-    Debug::log("Direction: (", unit_direction.x, ", ", unit_direction.y, ", ", unit_direction.z, ")");
+    RT_LOG_TRACE("Entering material: ", entering ? "yes" : "no");
+    RT_LOG_TRACE("Normal: (", normal.x, ", ", normal.y, ", ", normal.z, ")");
+    RT_LOG_TRACE("Direction: (", unit_direction.x, ", ", unit_direction.y, ", ", unit_direction.z, ")");
 
     // Set up indices of refraction
     double etaI = 1.0; // Air
@@ -128,33 +123,35 @@ Math::Vector3D GlassMaterial::computeInteraction(
     double cos_theta = std::abs(cos_theta_raw);
     double sin_theta = std::sqrt(1.0 - cos_theta * cos_theta);
 
-    Debug::log("eta_i: ", etaI, ", eta_t: ", etaT, ", ratio: ", ratio);
-    Debug::log("Cos theta raw: ", cos_theta_raw, ", Cos theta abs: ", cos_theta);
-    Debug::log("Sin theta: ", sin_theta);
+    RT_LOG_TRACE("eta_i: ", etaI, ", eta_t: ", etaT, ", ratio: ", ratio);
+    RT_LOG_TRACE("Cos theta raw: ", cos_theta_raw, ", Cos theta abs: ", cos_theta);
+    RT_LOG_TRACE("Sin theta: ", sin_theta);
 
     // Check for total internal reflection
     bool cannot_refract = ratio * sin_theta > 1.0;
-    Debug::log("Total internal reflection: ", cannot_refract ? "yes" : "no");
+    RT_LOG_TRACE("Total internal reflection: ", cannot_refract ? "yes" : "no");
 
     // Calculate reflection direction
     Math::Vector3D reflection_dir = unit_direction - normal * (2 * cos_theta_raw);
     reflection_dir = reflection_dir.normalize();
 
-    // Create reflection ray with small offset to avoid self-intersection
-    Ray reflection_ray(intersection.hitPoint + reflection_dir * 0.001, reflection_dir);
-    Math::Vector3D reflection_color = traceFunc(reflection_ray, depth + 1);
-    Debug::log("Reflection color: (", reflection_color.x, ", ", reflection_color.y, ", ", reflection_color.z, ")");
-
     // Calculate Fresnel term using Schlick's approximation
     double r0 = ((etaI - etaT) / (etaI + etaT)) * ((etaI - etaT) / (etaI + etaT));
     double schlick = r0 + (1.0 - r0) * std::pow(1.0 - cos_theta, 5);
-    Debug::log("R0: ", r0, ", Schlick: ", schlick);
+    RT_LOG_TRACE("R0: ", r0, ", Schlick: ", schlick);
+
+    // Create reflection ray with small offset to avoid self-intersection,
+    // its share of the result lets the tracer cut faint Fresnel branches
+    Ray reflection_ray(intersection.hitPoint + reflection_dir * 0.001, reflection_dir);
+    Math::Vector3D reflection_color = tracer.trace(reflection_ray, depth + 1,
+        transparency * (cannot_refract ? 1.0 : schlick));
+    RT_LOG_TRACE("Reflection color: (", reflection_color.x, ", ", reflection_color.y, ", ", reflection_color.z, ")");
 
     Math::Vector3D refraction_color;
 
     // Handle total internal reflection or compute refraction
     if (cannot_refract) {
-        Debug::log("Total internal reflection - using only reflection");
+        RT_LOG_TRACE("Total internal reflection - using only reflection");
         refraction_color = reflection_color;
     } else {
         // Calculate refraction direction using Snell's law
@@ -168,12 +165,13 @@ Math::Vector3D GlassMaterial::computeInteraction(
         Math::Vector3D refraction_dir = unit_direction * ratio + normal * normal_component;
         refraction_dir = refraction_dir.normalize();
 
-        Debug::log("Refraction dir: (", refraction_dir.x, ", ", refraction_dir.y, ", ", refraction_dir.z, ")");
+        RT_LOG_TRACE("Refraction dir: (", refraction_dir.x, ", ", refraction_dir.y, ", ", refraction_dir.z, ")");
 
         // Create refraction ray with small offset in the refraction direction
         Ray refraction_ray(intersection.hitPoint + refraction_dir * 0.001, refraction_dir);
-        refraction_color = traceFunc(refraction_ray, depth + 1);
-        Debug::log("Refraction color: (", refraction_color.x, ", ", refraction_color.y, ", ", refraction_color.z, ")");
+        refraction_color = tracer.trace(refraction_ray, depth + 1,
+            transparency * (1.0 - schlick));
+        RT_LOG_TRACE("Refraction color: (", refraction_color.x, ", ", refraction_color.y, ", ", refraction_color.z, ")");
     }
 
     // Use Fresnel to blend reflection and refraction
@@ -183,9 +181,9 @@ Math::Vector3D GlassMaterial::computeInteraction(
     // Apply material color as a tint, based on transparency
     Math::Vector3D final_color = color * (1.0 - transparency) + blend_color * transparency;
 
-    Debug::log("Schlick (reflectivity): ", schlick);
-    Debug::log("Final color: (", final_color.x, ", ", final_color.y, ", ", final_color.z, ")");
-    Debug::log("==============================");
+    RT_LOG_TRACE("Schlick (reflectivity): ", schlick);
+    RT_LOG_TRACE("Final color: (", final_color.x, ", ", final_color.y, ", ", final_color.z, ")");
+    RT_LOG_TRACE("==============================");
 
     return final_color;
 }
@@ -22,13 +22,13 @@ namespace Raytracer {
 Math::Vector3D IMaterial::computeInteraction(
     const Ray& incidentRay,
     const IntersectionInfo& intersection,
-    std::function<Math::Vector3D(const Ray&, int)> traceFunc,
+    ITracer& tracer,
     int depth) const
 {
 
     (void)incidentRay;
     (void)intersection;
-    (void)traceFunc;
+    (void)tracer;
     (void)depth;
 
     return getColor();
@@ -24,7 +24,6 @@
 #include "../core/Ray.hpp"
 #include "../core/Vector3D.hpp"
 #include "../interfaces/IMaterialInteraction.hpp"
-#include <functional>
 #include <memory>
 
 namespace Raytracer {
@@ -44,7 +43,7 @@ public:
     virtual Math::Vector3D computeInteraction(
         const Ray& incidentRay,
         const IntersectionInfo& intersection,
-        std::function<Math::Vector3D(const Ray&, int)> traceFunc,
+        ITracer& tracer,
         int depth) const override;
 
     // Clone method for copying materials
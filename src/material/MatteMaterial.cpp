@@ -38,13 +38,13 @@ std::unique_ptr<IMaterial> MatteMaterial::clone() const
 Math::Vector3D MatteMaterial::computeInteraction(
     const Ray& incidentRay,
     const IntersectionInfo& intersection,
-    std::function<Math::Vector3D(const Ray&, int)> traceFunc,
+    ITracer& tracer,
     int depth) const
 {
 
     (void)incidentRay;
     (void)intersection;
-    (void)traceFunc;
+    (void)tracer;
     (void)depth;
 
     return color;
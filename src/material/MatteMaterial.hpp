@@ -33,7 +33,7 @@ public:
     Math::Vector3D computeInteraction(
         const Ray& incidentRay,
         const IntersectionInfo& intersection,
-        std::function<Math::Vector3D(const Ray&, int)> traceFunc,
+        ITracer& tracer,
         int depth) const override;
 };
 
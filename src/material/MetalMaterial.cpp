@@ -18,7 +18,6 @@
 #include "MetalMaterial.hpp"
 #include <algorithm>
 #include <cmath>
-#include <random>
 
 namespace Raytracer {
 
@@ -64,7 +63,7 @@ std::unique_ptr<IMaterial> MetalMaterial::clone() const
 Math::Vector3D MetalMaterial::computeInteraction(
     const Ray& incidentRay,
     const IntersectionInfo& intersection,
-    std::function<Math::Vector3D(const Ray&, int)> traceFunc,
+    ITracer& tracer,
     int depth) const
 {
 
@@ -77,32 +76,29 @@ Math::Vector3D MetalMaterial::computeInteraction(
 
     // Add randomness based on roughness
     if (roughness > 0) {
-        reflectionDir = (reflectionDir + randomUnitVector() * roughness).normalize();
+        reflectionDir = (reflectionDir + randomUnitVector(tracer.getSampler()) * roughness).normalize();
     }
 
     // Create reflection ray with small offset to avoid self-intersection
     Ray reflectionRay(intersection.hitPoint + reflectionDir * 0.001, reflectionDir);
 
     // Get reflected color by recursively tracing
-    Math::Vector3D reflectionColor = traceFunc(reflectionRay, depth + 1);
+    Math::Vector3D reflectionColor = tracer.trace(reflectionRay, depth + 1, reflectivity);
 
     // Blend with base color according to reflectivity
     return color * (1.0 - reflectivity) + reflectionColor * reflectivity;
 }
 
-Math::Vector3D MetalMaterial::randomUnitVector() const
+Math::Vector3D MetalMaterial::randomUnitVector(ISampler& sampler) const
 {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_real_distribution<double> dis(-1.0, 1.0);
-
-    // Create a random vector and normalize
-    Math::Vector3D v;
-    do {
-        v = Math::Vector3D(dis(gen), dis(gen), dis(gen));
-    } while (v.length() >= 1.0);
-
-    return v.normalize();
+    // Map a 2D sample uniformly onto the sphere, so that stratified and
+    // low-discrepancy points stay well spread once on the sphere
+    Sample2D sample = sampler.next2D();
+    double z = 1.0 - 2.0 * sample.u;
+    double r = std::sqrt(std::max(0.0, 1.0 - z * z));
+    double phi = 2.0 * M_PI * sample.v;
+
+    return Math::Vector3D(r * std::cos(phi), r * std::sin(phi), z);
 }
 
 } // namespace Raytracer
\ No newline at end of file
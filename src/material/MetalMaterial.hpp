@@ -40,12 +40,12 @@ public:
     Math::Vector3D computeInteraction(
         const Ray& incidentRay,
         const IntersectionInfo& intersection,
-        std::function<Math::Vector3D(const Ray&, int)> traceFunc,
+        ITracer& tracer,
         int depth) const override;
 
 private:
-    // Function to create a random unit vector within the unit sphere
-    Math::Vector3D randomUnitVector() const;
+    // Random direction, uniformly distributed over the unit sphere
+    Math::Vector3D randomUnitVector(ISampler& sampler) const;
 };
 
 } // namespace Raytracer
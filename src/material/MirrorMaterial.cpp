@@ -56,7 +56,7 @@ std::unique_ptr<IMaterial> MirrorMaterial::clone() const
 Math::Vector3D MirrorMaterial::computeInteraction(
     const Ray& incidentRay,
     const IntersectionInfo& intersection,
-    std::function<Math::Vector3D(const Ray&, int)> traceFunc,
+    ITracer& tracer,
     int depth) const
 {
     // Calculate reflection direction
@@ -68,12 +68,6 @@ Math::Vector3D MirrorMaterial::computeInteraction(
     Math::Vector3D reflectionDir = incident - normal * (2.0 * dot);
     reflectionDir = reflectionDir.normalize();
 
-    // Add offset to avoid self-intersection
-    Ray reflectionRay(intersection.hitPoint + reflectionDir * 0.001, reflectionDir);
-
-    // Trace reflection ray
-    Math::Vector3D reflectionColor = traceFunc(reflectionRay, depth + 1);
-
     // Calculate Fresnel factor based on angle
     double fresnel = reflectivity;
     double cosTheta = fabs(incident.dot(normal));
@@ -82,6 +76,12 @@ Math::Vector3D MirrorMaterial::computeInteraction(
         fresnel = reflectivity + (1.0 - reflectivity) * pow(1.0 - cosTheta, 3);
     }
 
+    // Add offset to avoid self-intersection
+    Ray reflectionRay(intersection.hitPoint + reflectionDir * 0.001, reflectionDir);
+
+    // Trace reflection ray
+    Math::Vector3D reflectionColor = tracer.trace(reflectionRay, depth + 1, fresnel);
+
     // Apply material color tint and reflectivity
     return color * (1.0 - fresnel) + reflectionColor * fresnel;
 }
@@ -62,7 +62,7 @@ std::unique_ptr<IMaterial> TranslucentMaterial::clone() const
 Math::Vector3D TranslucentMaterial::computeInteraction(
     const Ray& incidentRay,
     const IntersectionInfo& intersection,
-    std::function<Math::Vector3D(const Ray&, int)> traceFunc,
+    ITracer& tracer,
     int depth) const
 {
 
@@ -91,7 +91,7 @@ Math::Vector3D TranslucentMaterial::computeInteraction(
         reflectionDir = reflectionDir.normalize();
 
         Ray reflectionRay(intersection.hitPoint + reflectionDir * 0.001, reflectionDir);
-        Math::Vector3D reflectionColor = traceFunc(reflectionRay, depth + 1);
+        Math::Vector3D reflectionColor = tracer.trace(reflectionRay, depth + 1, transparency);
 
         return color * (1.0 - transparency) + reflectionColor * transparency;
     } else {
@@ -104,7 +104,7 @@ Math::Vector3D TranslucentMaterial::computeInteraction(
         Ray refractionRay(intersection.hitPoint + refractionDir * 0.001, refractionDir);
 
         // Get refraction color
-        Math::Vector3D refractionColor = traceFunc(refractionRay, depth + 1);
+        Math::Vector3D refractionColor = tracer.trace(refractionRay, depth + 1, transparency);
 
         // Blend with base color based on transparency
         return color * (1.0 - transparency) + refractionColor * transparency;
@@ -0,0 +1,35 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** FrameBuffer.cpp
+*/
+#include "FrameBuffer.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace Raytracer {
+
+FrameBuffer::FrameBuffer(int width, int height)
+    : _width(0)
+    , _height(0)
+{
+    resize(width, height);
+}
+
+void FrameBuffer::resize(int width, int height)
+{
+    if (width < 0 || height < 0)
+        throw std::invalid_argument("Invalid frame buffer dimensions");
+
+    _width = width;
+    _height = height;
+    _data.assign(3 * static_cast<std::size_t>(width) * height, 0.0f);
+}
+
+void FrameBuffer::clear()
+{
+    std::fill(_data.begin(), _data.end(), 0.0f);
+}
+
+} // namespace Raytracer
@@ -0,0 +1,61 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** FrameBuffer.hpp
+*/
+#ifndef FRAME_BUFFER_HPP
+#define FRAME_BUFFER_HPP
+
+#include "../../core/Vector3D.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Raytracer {
+
+// Linear RGB image stored as packed floats, row 0 at the top. Threads may
+// write distinct pixels concurrently.
+class FrameBuffer {
+public:
+    FrameBuffer(int width = 0, int height = 0);
+
+    void resize(int width, int height);
+    void clear();
+
+    void setPixel(int x, int y, const Math::Vector3D& color)
+    {
+        float* p = &_data[3 * (static_cast<std::size_t>(y) * _width + x)];
+        p[0] = static_cast<float>(color.x);
+        p[1] = static_cast<float>(color.y);
+        p[2] = static_cast<float>(color.z);
+    }
+
+    Math::Vector3D getPixel(int x, int y) const
+    {
+        const float* p = &_data[3 * (static_cast<std::size_t>(y) * _width + x)];
+        return Math::Vector3D(p[0], p[1], p[2]);
+    }
+
+    int getWidth() const { return _width; }
+    int getHeight() const { return _height; }
+    const float* data() const { return _data.data(); }
+    const float* row(int y) const { return &_data[3 * static_cast<std::size_t>(y) * _width]; }
+
+    // Clamps a channel to [0, 1] and scales it to 8 bits, NaN maps to 0
+    static std::uint8_t toByte(float value)
+    {
+        if (!(value > 0.0f))
+            return 0;
+        return static_cast<std::uint8_t>(255 * (value < 1.0f ? value : 1.0f));
+    }
+
+private:
+    int _width;
+    int _height;
+    std::vector<float> _data;
+};
+
+} // namespace Raytracer
+
+#endif /* FRAME_BUFFER_HPP */
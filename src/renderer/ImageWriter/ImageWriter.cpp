@@ -0,0 +1,269 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** ImageWriter.cpp
+*/
+#include "ImageWriter.hpp"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace Raytracer {
+
+namespace {
+
+    const std::array<std::uint32_t, 256>& crcTable()
+    {
+        static const std::array<std::uint32_t, 256> table = [] {
+            std::array<std::uint32_t, 256> t {};
+            for (std::uint32_t n = 0; n < 256; n++) {
+                std::uint32_t c = n;
+                for (int k = 0; k < 8; k++)
+                    c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+                t[n] = c;
+            }
+            return t;
+        }();
+        return table;
+    }
+
+    std::uint32_t updateCrc(std::uint32_t crc, const std::uint8_t* data, std::size_t size)
+    {
+        const auto& table = crcTable();
+        for (std::size_t i = 0; i < size; i++)
+            crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+        return crc;
+    }
+
+    void putBigEndian(std::vector<std::uint8_t>& out, std::uint32_t value)
+    {
+        out.push_back(static_cast<std::uint8_t>(value >> 24));
+        out.push_back(static_cast<std::uint8_t>(value >> 16));
+        out.push_back(static_cast<std::uint8_t>(value >> 8));
+        out.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    void writeChunk(std::ostream& out, const char type[4], const std::vector<std::uint8_t>& data)
+    {
+        std::vector<std::uint8_t> header;
+        putBigEndian(header, static_cast<std::uint32_t>(data.size()));
+        header.insert(header.end(), type, type + 4);
+
+        std::uint32_t crc = updateCrc(0xffffffffu, header.data() + 4, 4);
+        crc = updateCrc(crc, data.data(), data.size()) ^ 0xffffffffu;
+
+        std::vector<std::uint8_t> trailer;
+        putBigEndian(trailer, crc);
+
+        out.write(reinterpret_cast<const char*>(header.data()), header.size());
+        out.write(reinterpret_cast<const char*>(data.data()), data.size());
+        out.write(reinterpret_cast<const char*>(trailer.data()), trailer.size());
+    }
+
+    // zlib stream made of stored deflate blocks, one IDAT chunk per block so
+    // that memory stays bounded by the 64 KiB block size
+    class IdatStream {
+    public:
+        explicit IdatStream(std::ostream& out)
+            : _out(out)
+        {
+            _block.reserve(MAX_BLOCK);
+        }
+
+        void put(const std::uint8_t* data, std::size_t size)
+        {
+            updateAdler(data, size);
+            while (size > 0) {
+                std::size_t n = std::min(size, MAX_BLOCK - _block.size());
+                _block.insert(_block.end(), data, data + n);
+                data += n;
+                size -= n;
+                if (_block.size() == MAX_BLOCK)
+                    flush(false);
+            }
+        }
+
+        void finish() { flush(true); }
+
+    private:
+        static constexpr std::size_t MAX_BLOCK = 65535;
+        static constexpr std::uint32_t ADLER_MOD = 65521;
+        // Largest run of bytes whose sums cannot overflow 32 bits
+        static constexpr std::size_t ADLER_NMAX = 5552;
+
+        void updateAdler(const std::uint8_t* data, std::size_t size)
+        {
+            while (size > 0) {
+                std::size_t n = std::min(size, ADLER_NMAX);
+                for (std::size_t i = 0; i < n; i++) {
+                    _adlerA += data[i];
+                    _adlerB += _adlerA;
+                }
+                _adlerA %= ADLER_MOD;
+                _adlerB %= ADLER_MOD;
+                data += n;
+                size -= n;
+            }
+        }
+
+        void flush(bool final)
+        {
+            std::vector<std::uint8_t> chunk;
+            chunk.reserve(_block.size() + 11);
+            if (_first) {
+                chunk.push_back(0x78); // Deflate, 32 KiB window
+                chunk.push_back(0x01); // No preset dictionary, fastest level
+                _first = false;
+            }
+
+            auto len = static_cast<std::uint16_t>(_block.size());
+            chunk.push_back(final ? 1 : 0); // BFINAL, BTYPE = 00 (stored)
+            chunk.push_back(static_cast<std::uint8_t>(len));
+            chunk.push_back(static_cast<std::uint8_t>(len >> 8));
+            chunk.push_back(static_cast<std::uint8_t>(~len));
+            chunk.push_back(static_cast<std::uint8_t>(~len >> 8));
+            chunk.insert(chunk.end(), _block.begin(), _block.end());
+
+            if (final)
+                putBigEndian(chunk, (_adlerB << 16) | _adlerA);
+
+            writeChunk(_out, "IDAT", chunk);
+            _block.clear();
+        }
+
+        std::ostream& _out;
+        std::vector<std::uint8_t> _block;
+        std::uint32_t _adlerA = 1;
+        std::uint32_t _adlerB = 0;
+        bool _first = true;
+    };
+
+    std::string lowercase(std::string value)
+    {
+        std::transform(value.begin(), value.end(), value.begin(),
+            [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return value;
+    }
+
+} // namespace
+
+ImageFormat ImageWriter::formatFromName(const std::string& name)
+{
+    std::string lower = lowercase(name);
+    if (lower == "ppm")
+        return ImageFormat::PPM;
+    if (lower == "png")
+        return ImageFormat::PNG;
+    if (lower == "pfm")
+        return ImageFormat::PFM;
+    throw std::invalid_argument("Unknown image format: " + name);
+}
+
+ImageFormat ImageWriter::formatFromPath(const std::string& path)
+{
+    std::size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos || path.find_first_of("/\\", dot) != std::string::npos)
+        return ImageFormat::PPM;
+
+    try {
+        return formatFromName(path.substr(dot + 1));
+    } catch (const std::invalid_argument&) {
+        return ImageFormat::PPM;
+    }
+}
+
+void ImageWriter::write(const FrameBuffer& image, const std::string& path)
+{
+    write(image, path, formatFromPath(path));
+}
+
+void ImageWriter::write(const FrameBuffer& image, const std::string& path,
+    ImageFormat format)
+{
+    std::ofstream file(path, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("Failed to open " + path + " for writing");
+
+    switch (format) {
+    case ImageFormat::PPM:
+        writePPM(image, file);
+        break;
+    case ImageFormat::PNG:
+        writePNG(image, file);
+        break;
+    case ImageFormat::PFM:
+        writePFM(image, file);
+        break;
+    }
+
+    if (!file)
+        throw std::runtime_error("Failed to write " + path);
+}
+
+void ImageWriter::writePPM(const FrameBuffer& image, std::ostream& out)
+{
+    int width = image.getWidth();
+    std::vector<std::uint8_t> row(3 * static_cast<std::size_t>(width));
+
+    out << "P6\n"
+        << width << " " << image.getHeight() << "\n255\n";
+    for (int y = 0; y < image.getHeight(); y++) {
+        const float* pixels = image.row(y);
+        for (std::size_t i = 0; i < row.size(); i++)
+            row[i] = FrameBuffer::toByte(pixels[i]);
+        out.write(reinterpret_cast<const char*>(row.data()), row.size());
+    }
+}
+
+void ImageWriter::writePNG(const FrameBuffer& image, std::ostream& out)
+{
+    static const std::uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+    out.write(reinterpret_cast<const char*>(signature), sizeof(signature));
+
+    std::vector<std::uint8_t> header;
+    putBigEndian(header, static_cast<std::uint32_t>(image.getWidth()));
+    putBigEndian(header, static_cast<std::uint32_t>(image.getHeight()));
+    header.push_back(8); // Bit depth
+    header.push_back(2); // Truecolor RGB
+    header.push_back(0); // Deflate
+    header.push_back(0); // Adaptive filtering
+    header.push_back(0); // No interlace
+    writeChunk(out, "IHDR", header);
+
+    // Each scanline starts with its filter type, 0 = none
+    std::vector<std::uint8_t> row(1 + 3 * static_cast<std::size_t>(image.getWidth()));
+    IdatStream idat(out);
+    for (int y = 0; y < image.getHeight(); y++) {
+        const float* pixels = image.row(y);
+        row[0] = 0;
+        for (std::size_t i = 1; i < row.size(); i++)
+            row[i] = FrameBuffer::toByte(pixels[i - 1]);
+        idat.put(row.data(), row.size());
+    }
+    idat.finish();
+
+    writeChunk(out, "IEND", {});
+}
+
+void ImageWriter::writePFM(const FrameBuffer& image, std::ostream& out)
+{
+    // A negative scale marks little-endian samples
+    const std::uint16_t probe = 1;
+    bool littleEndian = *reinterpret_cast<const std::uint8_t*>(&probe) == 1;
+
+    out << "PF\n"
+        << image.getWidth() << " " << image.getHeight() << "\n"
+        << (littleEndian ? "-1.0" : "1.0") << "\n";
+
+    // PFM scanlines go from bottom to top
+    std::size_t rowBytes = 3 * static_cast<std::size_t>(image.getWidth()) * sizeof(float);
+    for (int y = image.getHeight() - 1; y >= 0; y--)
+        out.write(reinterpret_cast<const char*>(image.row(y)), rowBytes);
+}
+
+} // namespace Raytracer
@@ -0,0 +1,42 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** ImageWriter.hpp
+*/
+#ifndef IMAGE_WRITER_HPP
+#define IMAGE_WRITER_HPP
+
+#include "../FrameBuffer/FrameBuffer.hpp"
+#include <ostream>
+#include <string>
+
+namespace Raytracer {
+
+enum class ImageFormat {
+    PPM, // Binary P6, 8 bits per channel
+    PNG, // RGB8, stored (uncompressed) deflate blocks
+    PFM, // 32-bit float RGB, unclamped
+};
+
+// Streams a frame buffer to disk row by row, without building the whole
+// encoded image in memory
+class ImageWriter {
+public:
+    // "ppm", "png" or "pfm", throws on anything else
+    static ImageFormat formatFromName(const std::string& name);
+    // Picks the format from the file extension, PPM when it is unknown
+    static ImageFormat formatFromPath(const std::string& path);
+
+    static void write(const FrameBuffer& image, const std::string& path);
+    static void write(const FrameBuffer& image, const std::string& path,
+        ImageFormat format);
+
+    static void writePPM(const FrameBuffer& image, std::ostream& out);
+    static void writePNG(const FrameBuffer& image, std::ostream& out);
+    static void writePFM(const FrameBuffer& image, std::ostream& out);
+};
+
+} // namespace Raytracer
+
+#endif /* IMAGE_WRITER_HPP */
@@ -15,89 +15,104 @@ namespace Raytracer {
 
 LightRenderer::LightRenderer(
     const std::vector<std::unique_ptr<ILight>>& lights,
-    const std::vector<std::unique_ptr<IPrimitive>>& primitives,
+    const PrimitiveRenderer& primitiveRenderer,
     Math::Point3D cameraPosition)
     : _lights(lights)
-    , _primitives(primitives)
+    , _primitiveRenderer(primitiveRenderer)
     , _cameraPosition(cameraPosition)
 {
 }
 
 Math::Vector3D LightRenderer::computeLight(Math::Point3D hitPoint,
-    IPrimitive* prim)
+    IPrimitive* prim, std::size_t element)
 {
-    Math::Vector3D totalLight(0, 0, 0);
-    Math::Vector3D normal = prim->getNormal(hitPoint);
+    Math::Vector3D totalLight(0.1, 0.1, 0.1);
+    Math::Vector3D normal = prim->getElementNormal(hitPoint, element);
     Math::Vector3D viewDir = (_cameraPosition - hitPoint).normalize();
-
-    totalLight = Math::Vector3D(0.1, 0.1, 0.1);
+    ShadowQuery query;
 
     for (const auto& lightPtr : _lights) {
         const ILight& light = *lightPtr;
-        float lightIntensity = light.getIntensity();
 
         if (light.isAmbientLight()) {
+            float lightIntensity = light.getIntensity();
             totalLight += Math::Vector3D(lightIntensity, lightIntensity, lightIntensity);
             continue;
         }
+        if (directLight(light, hitPoint, normal, viewDir, query)
+            && !_primitiveRenderer.isOccluded(query.ray, query.maxDistance))
+            totalLight += query.contribution;
+    }
 
-        Math::Vector3D lightDir;
-        if (light.isDirectionalLight()) {
-            lightDir = -light.getDirection().normalize();
-        } else {
-            lightDir = (light.getOrigin() - hitPoint).normalize();
-        }
-
-        float dot = std::max(0.0, normal.dot(lightDir));
-        float shadow = computeShadow(hitPoint, light);
-        float diffuse = lightIntensity * dot * shadow;
-
-        Math::Vector3D contribution(diffuse, diffuse, diffuse);
+    return clampLight(totalLight);
+}
 
-        if (light.getShadingModel() == ShadingModel::PHONG) {
-            Math::Vector3D reflectDir = (normal * (2 * normal.dot(lightDir)) - lightDir).normalize();
-            float specStrength = 0.5f;
-            int shininess = 32;
+Math::Vector3D LightRenderer::gatherLight(const Math::Point3D& hitPoint,
+    IPrimitive* prim, std::size_t element,
+    std::vector<ShadowQuery>& queries) const
+{
+    Math::Vector3D totalLight(0.1, 0.1, 0.1);
+    Math::Vector3D normal = prim->getElementNormal(hitPoint, element);
+    Math::Vector3D viewDir = (_cameraPosition - hitPoint).normalize();
+    ShadowQuery query;
 
-            float specAngle = std::max(0.0, reflectDir.dot(viewDir));
-            float specular = specStrength * std::pow(specAngle, shininess) * lightIntensity * shadow;
+    for (const auto& lightPtr : _lights) {
+        const ILight& light = *lightPtr;
 
-            contribution += Math::Vector3D(specular, specular, specular);
+        if (light.isAmbientLight()) {
+            float lightIntensity = light.getIntensity();
+            totalLight += Math::Vector3D(lightIntensity, lightIntensity, lightIntensity);
+        } else if (directLight(light, hitPoint, normal, viewDir, query)) {
+            queries.push_back(query);
         }
-
-        totalLight += contribution;
     }
+    return totalLight;
+}
 
-    return Math::Vector3D(std::min(1.0, totalLight.x),
-        std::min(1.0, totalLight.y),
-        std::min(1.0, totalLight.z));
+Math::Vector3D LightRenderer::clampLight(const Math::Vector3D& light)
+{
+    return Math::Vector3D(std::min<Math::Real>(1, light.x),
+        std::min<Math::Real>(1, light.y),
+        std::min<Math::Real>(1, light.z));
 }
 
-float LightRenderer::computeShadow(const Math::Point3D& hitPoint,
-    const ILight& light)
+bool LightRenderer::directLight(const ILight& light,
+    const Math::Point3D& hitPoint, const Math::Vector3D& normal,
+    const Math::Vector3D& viewDir, ShadowQuery& query) const
 {
+    float lightIntensity = light.getIntensity();
     Math::Vector3D lightDir;
-    double maxDist = std::numeric_limits<double>::infinity();
 
+    query.maxDistance = std::numeric_limits<double>::infinity();
     if (light.isDirectionalLight()) {
         lightDir = -light.getDirection().normalize();
     } else {
-        lightDir = (light.getOrigin() - hitPoint);
-        maxDist = lightDir.length();
+        lightDir = light.getOrigin() - hitPoint;
+        query.maxDistance = lightDir.length();
         lightDir = lightDir.normalize();
     }
 
-    Math::Point3D shadowOrigin = hitPoint + lightDir * 0.001;
-    Ray shadowRay(shadowOrigin, lightDir);
+    float dot = std::max<Math::Real>(0, normal.dot(lightDir));
+    float diffuse = lightIntensity * dot;
 
-    for (const auto& prim : _primitives) {
-        double t = prim->hits(shadowRay);
-        if (t > 0 && t < maxDist) {
-            return 0.0f;
-        }
+    query.contribution = Math::Vector3D(diffuse, diffuse, diffuse);
+
+    if (light.getShadingModel() == ShadingModel::PHONG) {
+        Math::Vector3D reflectDir = (normal * (2 * normal.dot(lightDir)) - lightDir).normalize();
+        float specStrength = 0.5f;
+        int shininess = 32;
+
+        float specAngle = std::max<Math::Real>(0, reflectDir.dot(viewDir));
+        float specular = specStrength * std::pow(specAngle, shininess) * lightIntensity;
+
+        query.contribution += Math::Vector3D(specular, specular, specular);
     }
 
-    return 1.0f;
+    if (query.contribution.x == 0 && query.contribution.y == 0 && query.contribution.z == 0)
+        return false;
+
+    query.ray = Ray(hitPoint + lightDir * 0.001, lightDir);
+    return true;
 }
 
 } // namespace Raytracer
@@ -12,24 +12,46 @@
 #include "../../core/Vector3D.hpp"
 #include "../../interfaces/ILight.hpp"
 #include "../../interfaces/IPrimitive.hpp"
+#include "../PrimitiveRenderer/PrimitiveRenderer.hpp"
 #include <memory>
 #include <vector>
 
 namespace Raytracer {
 
+// Light a source sends to a hit point, unless the shadow ray is blocked
+struct ShadowQuery {
+    Ray ray;
+    double maxDistance;
+    Math::Vector3D contribution;
+};
+
 class LightRenderer {
 private:
     const std::vector<std::unique_ptr<ILight>>& _lights;
-    const std::vector<std::unique_ptr<IPrimitive>>& _primitives;
+    const PrimitiveRenderer& _primitiveRenderer;
     Math::Point3D _cameraPosition;
 
+    // False when the light cannot brighten the point, no shadow ray needed
+    bool directLight(const ILight& light, const Math::Point3D& hitPoint,
+        const Math::Vector3D& normal, const Math::Vector3D& viewDir,
+        ShadowQuery& query) const;
+
 public:
     LightRenderer(const std::vector<std::unique_ptr<ILight>>& lights,
-        const std::vector<std::unique_ptr<IPrimitive>>& primitives,
+        const PrimitiveRenderer& primitiveRenderer,
         Math::Point3D cameraPosition);
 
-    Math::Vector3D computeLight(Math::Point3D hitPoint, IPrimitive* prim);
-    float computeShadow(const Math::Point3D& hitPoint, const ILight& light);
+    Math::Vector3D computeLight(Math::Point3D hitPoint, IPrimitive* prim,
+        std::size_t element = 0);
+
+    // computeLight split in two for callers that trace the shadow rays of
+    // many hits at once: returns the light that needs no shadow ray and
+    // appends one query per light that may reach the point. Once the
+    // contributions of the unblocked queries are added, clampLight gives
+    // what computeLight would have returned.
+    Math::Vector3D gatherLight(const Math::Point3D& hitPoint, IPrimitive* prim,
+        std::size_t element, std::vector<ShadowQuery>& queries) const;
+    static Math::Vector3D clampLight(const Math::Vector3D& light);
 };
 
 } // namespace Raytracer
@@ -5,15 +5,49 @@
 ** PrimitiveRenderer.cpp
 */
 #include "PrimitiveRenderer.hpp"
+#include "../../builders/SceneCache.hpp"
 #include "../../utils/Debug.hpp"
+#include "../../utils/Timer.hpp"
 #include <limits>
 
 namespace Raytracer {
 
 PrimitiveRenderer::PrimitiveRenderer(
-    const std::vector<std::unique_ptr<IPrimitive>>& primitives)
+    const std::vector<std::unique_ptr<IPrimitive>>& primitives,
+    const std::vector<std::string>& sources)
     : _primitives(primitives)
 {
+    buildAccelerationStructure(sources);
+}
+
+void PrimitiveRenderer::buildAccelerationStructure(
+    const std::vector<std::string>& sources)
+{
+    Timer buildTimer("BVH build");
+
+    buildTimer.start();
+    for (const auto& prim : _primitives) {
+        AABB box = prim->getBoundingBox();
+        if (box.isFinite()) {
+            _bounded.push_back(prim.get());
+            _boundedBoxes.push_back(box);
+        } else {
+            _unbounded.push_back(prim.get());
+        }
+    }
+
+    bool cacheable = !sources.empty() && _boundedBoxes.size() >= SceneCache::MIN_PRIMITIVES;
+    if (cacheable && SceneCache::load(sources, _boundedBoxes, _bvh)) {
+        Debug::log("BVH loaded from cache: ", SceneCache::pathFor(sources.front()));
+    } else {
+        _bvh.build(_boundedBoxes);
+        if (cacheable)
+            SceneCache::save(sources, _boundedBoxes, _bvh);
+    }
+
+    Debug::log("BVH built over ", _bounded.size(), " primitives (",
+        _bvh.getNodes().size(), " nodes, ", _unbounded.size(),
+        " unbounded primitives) in ", buildTimer.elapsedString());
 }
 
 IPrimitive* PrimitiveRenderer::findClosestIntersection(const Ray& ray,
@@ -21,43 +55,125 @@ IPrimitive* PrimitiveRenderer::findClosestIntersection(const Ray& ray,
 {
     double closest_hit = std::numeric_limits<double>::max();
     IPrimitive* hitPrim = nullptr;
+    std::size_t hitElement = 0;
     int hitCount = 0;
 
-    for (auto& prim : _primitives) {
-        double t = prim->hits(ray);
+    for (IPrimitive* prim : _unbounded) {
+        std::size_t element;
+        double t = prim->hitsElement(ray, element);
         if (t > 0 && t < closest_hit) {
             closest_hit = t;
-            hitPrim = prim.get();
+            hitPrim = prim;
+            hitElement = element;
             hitCount++;
         }
     }
 
-    Debug::log("Found ", hitCount, " intersections, closest at t=", closest_hit);
+    _bvh.intersect(ray, closest_hit, [&](std::uint32_t index, double& tMax) {
+        std::size_t element;
+        double t = _bounded[index]->hitsElement(ray, element);
+        if (t > 0 && t < tMax) {
+            tMax = t;
+            hitPrim = _bounded[index];
+            hitElement = element;
+            hitCount++;
+            return true;
+        }
+        return false;
+    });
 
-    if (hitPrim) {
-        info.t = closest_hit;
-        info.hitPoint = ray.at(closest_hit);
+    RT_LOG_TRACE("Found ", hitCount, " intersections, closest at t=", closest_hit);
 
-        Math::Vector3D outward_normal = hitPrim->getNormal(info.hitPoint);
-        double dot_product = ray.direction.dot(outward_normal);
+    if (hitPrim)
+        fillIntersection(ray, hitPrim, closest_hit, hitElement, info);
 
-        info.frontFace = dot_product < 0;
+    return hitPrim;
+}
 
-        if (info.frontFace) {
-            info.normal = outward_normal;
-        } else {
-            info.normal = -outward_normal;
+void PrimitiveRenderer::findClosestPacket(const RayPacket& packet,
+    IPrimitive** hits, IntersectionInfo* infos)
+{
+    double closest[RayPacket::SIZE];
+    std::size_t elements[RayPacket::SIZE];
+    double t[RayPacket::SIZE];
+    std::size_t element[RayPacket::SIZE];
+
+    for (int i = 0; i < RayPacket::SIZE; i++) {
+        closest[i] = std::numeric_limits<double>::max();
+        hits[i] = nullptr;
+        elements[i] = 0;
+    }
+
+    // Same acceptance test as the single-ray search, lane by lane. The
+    // padding lanes follow the last active one and are never read back.
+    auto record = [&](IPrimitive* prim, double* tMax) {
+        prim->hitsPacket(packet, t, element);
+        for (int i = 0; i < RayPacket::SIZE; i++) {
+            if (t[i] > 0 && t[i] < tMax[i]) {
+                tMax[i] = t[i];
+                hits[i] = prim;
+                elements[i] = element[i];
+            }
         }
+    };
+
+    for (IPrimitive* prim : _unbounded)
+        record(prim, closest);
+
+    _bvh.intersectPacket(packet, closest,
+        [&](std::uint32_t index, double* tMax) { record(_bounded[index], tMax); });
 
-        Debug::log("Hit at point (", info.hitPoint.x, ", ", info.hitPoint.y, ", ",
-            info.hitPoint.z, ")");
-        Debug::log("Normal: (", info.normal.x, ", ", info.normal.y, ", ",
-            info.normal.z, ")");
-        Debug::log("Front face: ", info.frontFace ? "true" : "false");
-        Debug::log("Dot product: ", dot_product);
+    for (int i = 0; i < packet.count; i++) {
+        if (hits[i])
+            fillIntersection(packet.ray(i), hits[i], closest[i], elements[i], infos[i]);
     }
+}
 
-    return hitPrim;
+void PrimitiveRenderer::fillIntersection(const Ray& ray, IPrimitive* prim,
+    double t, std::size_t element, IntersectionInfo& info)
+{
+    info.t = t;
+    info.hitPoint = ray.at(t);
+    info.element = element;
+
+    Math::Vector3D outward_normal = prim->getElementNormal(info.hitPoint, element);
+    double dot_product = ray.direction.dot(outward_normal);
+
+    info.frontFace = dot_product < 0;
+
+    if (info.frontFace) {
+        info.normal = outward_normal;
+    } else {
+        info.normal = -outward_normal;
+    }
+
+    RT_LOG_TRACE("Hit at point (", info.hitPoint.x, ", ", info.hitPoint.y,
+        ", ", info.hitPoint.z, ")");
+    RT_LOG_TRACE("Normal: (", info.normal.x, ", ", info.normal.y, ", ",
+        info.normal.z, ")");
+    RT_LOG_TRACE("Front face: ", info.frontFace ? "true" : "false");
+    RT_LOG_TRACE("Dot product: ", dot_product);
+}
+
+bool PrimitiveRenderer::isOccluded(const Ray& ray, double maxDist) const
+{
+    for (IPrimitive* prim : _unbounded) {
+        double t = prim->hits(ray);
+        if (t > 0 && t < maxDist)
+            return true;
+    }
+
+    Math::Vector3D invDir = inverseDirection(ray.direction);
+
+    return _bvh.occluded(ray, maxDist, [&](std::uint32_t index, double tMax) {
+        // Leaves can be larger than the primitive: reject on its own box
+        // before paying for a full cone or cylinder intersection
+        Math::Real tEntry;
+        if (!_boundedBoxes[index].intersect(ray.origin, invDir, 0.0, tMax, tEntry))
+            return false;
+        double t = _bounded[index]->hits(ray);
+        return t > 0 && t < tMax;
+    });
 }
 
 } // namespace Raytracer
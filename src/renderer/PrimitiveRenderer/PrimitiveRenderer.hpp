@@ -7,10 +7,13 @@
 #ifndef PRIMITIVE_RENDERER_HPP
 #define PRIMITIVE_RENDERER_HPP
 
+#include "../../core/BVH.hpp"
 #include "../../core/Ray.hpp"
+#include "../../core/RayPacket.hpp"
 #include "../../core/Vector3D.hpp"
 #include "../../interfaces/IPrimitive.hpp"
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace Raytracer {
@@ -19,10 +22,34 @@ class PrimitiveRenderer {
 private:
     const std::vector<std::unique_ptr<IPrimitive>>& _primitives;
 
+    // Bounded primitives live in the BVH, the few unbounded ones (planes,
+    // infinite cylinders and cones) are tested linearly on every ray
+    std::vector<IPrimitive*> _bounded;
+    std::vector<AABB> _boundedBoxes;
+    std::vector<IPrimitive*> _unbounded;
+    BVH _bvh;
+
+    void buildAccelerationStructure(const std::vector<std::string>& sources);
+    static void fillIntersection(const Ray& ray, IPrimitive* prim, double t,
+        std::size_t element, IntersectionInfo& info);
+
 public:
-    PrimitiveRenderer(const std::vector<std::unique_ptr<IPrimitive>>& primitives);
+    // sources are the files the scene was read from, the BVH is cached
+    // next to the first one when there are any
+    PrimitiveRenderer(const std::vector<std::unique_ptr<IPrimitive>>& primitives,
+        const std::vector<std::string>& sources = {});
 
     IPrimitive* findClosestIntersection(const Ray& ray, IntersectionInfo& info);
+
+    // findClosestIntersection for the first packet.count lanes of a packet,
+    // traversing the BVH once for all of them. hits and infos hold
+    // RayPacket::SIZE entries, hits[i] is null when lane i misses.
+    void findClosestPacket(const RayPacket& packet, IPrimitive** hits,
+        IntersectionInfo* infos);
+
+    // Any-hit query for shadow rays: true as soon as something lies on the
+    // ray strictly between t = 0 and maxDist
+    bool isOccluded(const Ray& ray, double maxDist) const;
 };
 
 } // namespace Raytracer
@@ -8,37 +8,43 @@
 #include "../core/Camera.hpp"
 #include "../core/Ray.hpp"
 #include "../interfaces/IPrimitive.hpp"
+#include "../sampler/StratifiedSampler.hpp"
 #include "../utils/Debug.hpp"
 #include "LightRenderer/LightRenderer.hpp"
 #include "PrimitiveRenderer/PrimitiveRenderer.hpp"
+#include "TileScheduler/TileScheduler.hpp"
 #include <algorithm>
 #include <atomic>
 #include <cmath>
-#include <fstream>
+#include <condition_variable>
 #include <iomanip>
 #include <iostream>
 #include <memory>
 #include <mutex>
-#include <ostream>
-#include <sstream>
+#include <stdexcept>
 #include <thread>
 
 namespace Raytracer {
 
 Renderer::Renderer(SceneBuilder scene, int width, int height, int maxDepth,
-                   int samples)
+                   int samples, int threads)
     : _scene(std::move(scene)), _width(width), _height(height),
-      _maxDepth(maxDepth), _samples(samples), _backgroundColor(0, 0, 1),
-      renderResult(_width * _height) {
+      _maxDepth(maxDepth), _samples(samples), _threads(threads),
+      _backgroundColor(0, 0, 1), _frameBuffer(_width, _height),
+      _outputPath("output.ppm"), _outputFormat(ImageFormat::PPM),
+      _sampler(std::make_unique<StratifiedSampler>(samplesPerPixel())) {
+  if (_threads <= 0)
+    _threads = std::max(1u, std::thread::hardware_concurrency());
+
+  // Initialize specialized renderers, the light renderer casts its shadow
+  // rays through the primitive renderer's BVH
+  _primitiveRenderer = std::make_unique<PrimitiveRenderer>(
+      _scene.getPrimitives(), _scene.getSources());
 
-  // Initialize specialized renderers
   _lightRenderer = std::make_unique<LightRenderer>(
-      _scene.getLights(), _scene.getPrimitives(),
+      _scene.getLights(), *_primitiveRenderer,
       _scene.getCamera().getPosition());
 
-  _primitiveRenderer =
-      std::make_unique<PrimitiveRenderer>(_scene.getPrimitives());
-
   Debug::log("Renderer initialized with background color: ", _backgroundColor.x,
              ", ", _backgroundColor.y, ", ", _backgroundColor.z);
 }
@@ -49,60 +55,21 @@ void Renderer::render() {
              _samples, " samples per pixel");
 
   int totalPixels = _width * _height;
+  int passes = _progressive ? samplesPerPixel() : 1;
+  int completedPasses = 0;
   std::atomic<int> raysCast(0);
-  std::atomic<int> pixelsCompleted(0);
-  std::vector<std::thread> threads;
-  int numThreads = std::thread::hardware_concurrency();
-  std::mutex resultMutex;
-
-  renderResult.resize(totalPixels);
-
-  int rowsPerThread = (_height + numThreads - 1) / numThreads;
-
-  for (int i = 0; i < numThreads; i++) {
-    threads.emplace_back([&, i]() {
-      int startRow = i * rowsPerThread;
-      int endRow = std::min(startRow + rowsPerThread, _height);
-
-      for (int y = startRow; y < endRow; y++) {
-        for (int x = 0; x < _width; x++) {
-          Math::Vector3D pixelColor(0, 0, 0);
-
-          if (_samples > 1) {
-            for (int s = 0; s < _samples; s++) {
-              for (int t = 0; t < _samples; t++) {
-                double u = (x + (s + 0.5) / _samples) / (_width - 1);
-                double v = (y + (t + 0.5) / _samples) / (_height - 1);
-                Ray ray = _scene.getCamera().ray(u, v);
-                pixelColor += traceRay(ray, 0);
-                raysCast++;
-              }
-            }
-            pixelColor = pixelColor / (_samples * _samples);
-          } else {
-            double u = (double)x / (_width - 1);
-            double v = (double)y / (_height - 1);
-            Ray ray = _scene.getCamera().ray(u, v);
-            pixelColor = traceRay(ray, 0);
-            raysCast++;
-          }
-
-          renderResult[y * _width + x] = drawPixel(pixelColor);
-          pixelsCompleted++;
-        }
-      }
-    });
-  }
-
-  while (pixelsCompleted < totalPixels) {
-    int percent = (100 * pixelsCompleted) / totalPixels;
 
-    std::cerr << "\rProgress: " << percent << "%" << std::flush;
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-  }
-
-  for (auto &thread : threads) {
-    thread.join();
+  _frameBuffer.resize(_width, _height);
+  if (_progressive)
+    _estimates.assign(totalPixels, PixelEstimate());
+
+  for (int pass = 0; pass < passes && !_stopRequested; pass++) {
+    renderPass(pass, passes, raysCast);
+    if (_stopRequested)
+      break;
+    completedPasses++;
+    if (_passCallback)
+      _passCallback(completedPasses, passes);
   }
 
   double renderTime = renderTimer.elapsedSeconds();
@@ -111,11 +78,25 @@ void Renderer::render() {
 
   Debug::log("Render completed in ", renderTimer.elapsedString());
   std::cerr << "\n===== Render Statistics =====" << std::endl;
+  if (_stopRequested)
+    std::cerr << "Render stopped before completion" << std::endl;
   std::cerr << "Resolution: " << _width << "x" << _height << " (" << totalPixels
             << " pixels)" << std::endl;
   std::cerr << "Samples per pixel: " << _samples << " ("
             << (_samples * _samples) << " rays per pixel)" << std::endl;
+  if (_progressive)
+    std::cerr << "Progressive passes: " << completedPasses << "/" << passes
+              << std::endl;
+  if (_adaptiveThreshold > 0)
+    std::cerr << "Adaptive sampling: threshold " << _adaptiveThreshold << ", "
+              << std::fixed << std::setprecision(2)
+              << static_cast<double>(raysCast) / totalPixels
+              << " camera rays per pixel on average" << std::endl;
   std::cerr << "Maximum ray depth: " << _maxDepth << std::endl;
+  std::cerr << "Engine: "
+            << (_engine == RenderEngine::Wavefront ? "wavefront" : "recursive")
+            << std::endl;
+  std::cerr << "Threads: " << _threads << std::endl;
   std::cerr << "Total rays cast: " << raysCast << std::endl;
   std::cerr << "Total render time: " << renderTimer.elapsedString()
             << std::endl;
@@ -127,19 +108,264 @@ void Renderer::render() {
             << (renderTime / totalPixels * 1000) << " ms per pixel"
             << std::endl;
   std::cerr << "============================" << std::endl;
+}
+
+void Renderer::renderPass(int pass, int passes, std::atomic<int> &raysCast) {
+  long long totalPixels = static_cast<long long>(_width) * _height;
+  std::atomic<int> pixelsCompleted(0);
+  int activeWorkers = _threads;
+  std::mutex workerMutex;
+  std::condition_variable workersDone;
+  std::vector<std::thread> threads;
+  TileScheduler scheduler(_width, _height, _threads);
+
+  for (int i = 0; i < _threads; i++) {
+    threads.emplace_back([&, i]() {
+      std::unique_ptr<ISampler> sampler = _sampler->clone();
+      WavefrontIntegrator wavefront(*this, *_primitiveRenderer,
+                                    *_lightRenderer, _backgroundColor,
+                                    _maxDepth);
+      Tile tile;
+
+      while (!_stopRequested && scheduler.next(i, tile)) {
+        int tileRays =
+            _engine == RenderEngine::Wavefront
+                ? renderTileWavefront(tile, pass, *sampler, wavefront)
+                : renderTile(tile, pass, *sampler);
+
+        raysCast += tileRays;
+        pixelsCompleted += (tile.x1 - tile.x0) * (tile.y1 - tile.y0);
+        if (_tileCallback)
+          _tileCallback(tile);
+      }
+
+      std::lock_guard<std::mutex> lock(workerMutex);
+      if (--activeWorkers == 0)
+        workersDone.notify_one();
+    });
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(workerMutex);
+    while (!workersDone.wait_for(lock, std::chrono::milliseconds(100),
+                                 [&]() { return activeWorkers == 0; })) {
+      long long done = pass * totalPixels + pixelsCompleted;
+      int percent = static_cast<int>((100 * done) / (passes * totalPixels));
+
+      std::cerr << "\rProgress: " << percent << "%" << std::flush;
+    }
+  }
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+int Renderer::renderTile(const Tile &tile, int pass, ISampler &sampler) {
+  int tileRays = 0;
+
+  for (int y = tile.y0; y < tile.y1; y++) {
+    for (int x = tile.x0; x < tile.x1; x++) {
+      if (!_progressive) {
+        _frameBuffer.setPixel(x, y, samplePixel(x, y, tileRays, sampler));
+        continue;
+      }
+      // Each pass adds one sample and shows the running average
+      PixelEstimate &estimate = _estimates[y * _width + x];
+      if (isConverged(estimate))
+        continue;
+      estimate.add(sampleAt(x, y, pass, sampler));
+      tileRays++;
+      _frameBuffer.setPixel(x, y, estimate.mean);
+    }
+  }
+  return tileRays;
+}
+
+int Renderer::renderTileWavefront(const Tile &tile, int pass,
+                                  ISampler &sampler,
+                                  WavefrontIntegrator &wavefront) {
+  int tileWidth = tile.x1 - tile.x0;
+  int pixels = tileWidth * (tile.y1 - tile.y0);
+  std::vector<PixelEstimate> local;
+  std::vector<PixelSample> batch;
+  std::vector<std::size_t> owners;
+  std::vector<Math::Vector3D> colors;
+  int tileRays = 0;
+
+  if (!_progressive)
+    local.assign(pixels, PixelEstimate());
+  auto estimateAt = [&](int i) -> PixelEstimate & {
+    if (!_progressive)
+      return local[i];
+    return _estimates[(tile.y0 + i / tileWidth) * _width + tile.x0 +
+                      i % tileWidth];
+  };
+
+  // Without adaptive sampling nothing is learnt between two samples of a
+  // pixel, so a batch takes several of them to keep the queues long
+  int perPixel = 1;
+  if (!_progressive && _adaptiveThreshold <= 0)
+    perPixel = std::max(1, WAVEFRONT_BATCH / pixels);
+
+  while (true) {
+    batch.clear();
+    owners.clear();
+    for (int i = 0; i < pixels; i++) {
+      const PixelEstimate &estimate = estimateAt(i);
+      if (isConverged(estimate))
+        continue;
+      int first = _progressive ? pass : estimate.count;
+      int count =
+          _progressive ? 1 : std::min(perPixel, samplesPerPixel() - first);
+      for (int s = first; s < first + count; s++) {
+        batch.push_back({tile.x0 + i % tileWidth, tile.y0 + i / tileWidth, s});
+        owners.push_back(i);
+      }
+    }
+    if (batch.empty())
+      break;
+
+    wavefront.render(batch, colors, sampler);
+    for (std::size_t j = 0; j < batch.size(); j++)
+      estimateAt(owners[j]).add(colors[j]);
+    tileRays += batch.size();
+    if (_progressive)
+      break;
+  }
+
+  for (int i = 0; i < pixels; i++)
+    _frameBuffer.setPixel(tile.x0 + i % tileWidth, tile.y0 + i / tileWidth,
+                          estimateAt(i).mean);
+  return tileRays;
+}
+
+void Renderer::save() const {
+  Timer writeTimer("Image write");
+  writeTimer.start();
+  ImageWriter::write(_frameBuffer, _outputPath, _outputFormat);
+  std::cerr << "Image written to " << _outputPath << " in "
+            << writeTimer.elapsedString() << std::endl;
+}
+
+void Renderer::setOutput(const std::string &path, ImageFormat format) {
+  _outputPath = path;
+  _outputFormat = format;
+}
+
+void Renderer::setTileCallback(std::function<void(const Tile &)> callback) {
+  _tileCallback = std::move(callback);
+}
+
+void Renderer::setProgressive(bool progressive) { _progressive = progressive; }
+
+void Renderer::setPassCallback(std::function<void(int, int)> callback) {
+  _passCallback = std::move(callback);
+}
+
+void Renderer::stop() { _stopRequested = true; }
 
-  std::ofstream file("output.ppm");
-  if (!file)
-    throw std::runtime_error("Failed to open output.ppm for writing");
+int Renderer::samplesPerPixel() const {
+  return _samples > 1 ? _samples * _samples : 1;
+}
+
+void Renderer::setAdaptiveThreshold(double threshold) {
+  _adaptiveThreshold = threshold;
+}
 
-  file << "P3\n" << _width << " " << _height << "\n255\n";
-  for (const auto &pixel : renderResult)
+void Renderer::setEngine(RenderEngine engine) { _engine = engine; }
 
-    file << pixel;
-  file.close();
+RenderEngine Renderer::engineFromName(const std::string &name) {
+  if (name == "recursive")
+    return RenderEngine::Recursive;
+  if (name == "wavefront")
+    return RenderEngine::Wavefront;
+  throw std::invalid_argument("Unknown render engine: " + name);
 }
 
-Math::Vector3D Renderer::traceRay(Ray &ray, int depth) {
+void Renderer::setSampler(std::unique_ptr<ISampler> sampler) {
+  if (!sampler)
+    throw std::invalid_argument("Renderer needs a sampler");
+  _sampler = std::move(sampler);
+}
+
+bool Renderer::isConverged(const PixelEstimate &estimate) const {
+  // A few samples first, the variance of one or two is meaningless
+  const int minSamples = std::min(4, samplesPerPixel());
+
+  if (estimate.count >= samplesPerPixel())
+    return true;
+  return _adaptiveThreshold > 0 && estimate.count >= minSamples &&
+         estimate.standardError() <= _adaptiveThreshold;
+}
+
+Math::Vector3D Renderer::sampleAt(int x, int y, int sample,
+                                  ISampler &sampler) {
+  Ray ray = cameraRay(x, y, sample, sampler);
+  SampleTracer tracer(*this, sampler);
+  return traceRay(ray, 0, tracer);
+}
+
+Ray Renderer::cameraRay(int x, int y, int sample, ISampler &sampler) {
+  double u, v;
+
+  cameraPosition(x, y, sample, sampler, u, v);
+  return _scene.getCamera().ray(u, v);
+}
+
+void Renderer::cameraPosition(int x, int y, int sample, ISampler &sampler,
+                              double &u, double &v) {
+  sampler.startSample(x, y, sample);
+  if (_samples <= 1) {
+    u = (double)x / (_width - 1);
+    v = (double)y / (_height - 1);
+  } else {
+    // The sampler's first two dimensions place the ray on the pixel
+    Sample2D offset = sampler.next2D();
+    u = (x + offset.u) / (_width - 1);
+    v = (y + offset.v) / (_height - 1);
+  }
+}
+
+Math::Vector3D Renderer::samplePixel(int x, int y, int &raysCast,
+                                     ISampler &sampler) {
+  PixelEstimate estimate;
+
+  while (!isConverged(estimate)) {
+    estimate.add(sampleAt(x, y, estimate.count, sampler));
+    raysCast++;
+  }
+  return estimate.mean;
+}
+
+double Renderer::SampleTracer::survival(double throughput,
+                                        ISampler &sampler) {
+  if (throughput < ROULETTE_WEIGHT) {
+    double probability = throughput / ROULETTE_WEIGHT;
+    return sampler.next1D() < probability ? probability : 0.0;
+  }
+  return 1.0;
+}
+
+Math::Vector3D Renderer::SampleTracer::trace(const Ray &ray, int depth,
+                                             double weight) {
+  double throughput = _throughput * weight;
+  double survival = SampleTracer::survival(throughput, _sampler);
+
+  if (survival <= 0)
+    return Math::Vector3D(0, 0, 0);
+
+  RT_LOG_TRACE("Tracing recursive ray at depth ", depth, " with throughput ",
+               throughput);
+  double parent = _throughput;
+  _throughput = throughput / survival;
+  Math::Vector3D color = _renderer.traceRay(ray, depth, *this);
+  _throughput = parent;
+  return color / survival;
+}
+
+Math::Vector3D Renderer::traceRay(const Ray &ray, int depth,
+                                  ITracer &tracer) {
   if (depth >= _maxDepth) {
     return _backgroundColor;
   }
@@ -149,43 +375,28 @@ Math::Vector3D Renderer::traceRay(Ray &ray, int depth) {
       _primitiveRenderer->findClosestIntersection(ray, intersection);
 
   if (hitPrim) {
-    auto material = hitPrim->getMaterial();
-    Math::Vector3D materialColor = material->getColor();
+    const IMaterial *material = hitPrim->getMaterial();
 
-    Debug::log("Material type: ", typeid(*material).name(), " Color: (",
-               material->getColor().x, ", ", material->getColor().y, ", ",
-               material->getColor().z, ")");
+    RT_LOG_TRACE("Material type: ", typeid(*material).name(), " Color: (",
+                 material->getColor().x, ", ", material->getColor().y, ", ",
+                 material->getColor().z, ")");
 
     Math::Vector3D lightCoefficient =
-        _lightRenderer->computeLight(intersection.hitPoint, hitPrim);
-
-    auto traceFunc = [this](const Ray &r, int d) -> Math::Vector3D {
-      Debug::log("Tracing recursive ray at depth ", d);
-      return this->traceRay(const_cast<Ray &>(r), d);
-    };
+        _lightRenderer->computeLight(intersection.hitPoint, hitPrim,
+                                     intersection.element);
 
     Math::Vector3D finalColor =
-        material->computeInteraction(ray, intersection, traceFunc, depth);
-
-    Debug::log("Final color: (", materialColor.x * lightCoefficient.x, ", ",
-               materialColor.y * lightCoefficient.y, ", ",
-               materialColor.z * lightCoefficient.z, ")");
-    return Math::Vector3D(finalColor.x * lightCoefficient.x,
-                          finalColor.y * lightCoefficient.y,
-                          finalColor.z * lightCoefficient.z);
+        material->computeInteraction(ray, intersection, tracer, depth);
+
+    Math::Vector3D color(finalColor.x * lightCoefficient.x,
+                         finalColor.y * lightCoefficient.y,
+                         finalColor.z * lightCoefficient.z);
+
+    RT_LOG_TRACE("Final color: (", color.x, ", ", color.y, ", ", color.z, ")");
+    return color;
   } else {
     return _backgroundColor;
   }
 }
 
-std::string Renderer::drawPixel(const Math::Vector3D &color) {
-  int r = static_cast<int>(255 * std::min(1.0, std::max(0.0, color.x)));
-  int g = static_cast<int>(255 * std::min(1.0, std::max(0.0, color.y)));
-  int b = static_cast<int>(255 * std::min(1.0, std::max(0.0, color.z)));
-  std::ostringstream oss;
-
-  oss << r << " " << g << " " << b << "\n";
-  return oss.str();
-}
-
 } // namespace Raytracer
@@ -8,16 +8,58 @@
 #define RENDERER_HPP
 #include "../builders/SceneBuilder.hpp"
 #include "../interfaces/IMaterialInteraction.hpp"
+#include "../interfaces/ISampler.hpp"
+#include "../interfaces/ITracer.hpp"
 #include "../utils/Debug.hpp"
 #include "../utils/Timer.hpp"
+#include "FrameBuffer/FrameBuffer.hpp"
+#include "ImageWriter/ImageWriter.hpp"
 #include "LightRenderer/LightRenderer.hpp"
 #include "PrimitiveRenderer/PrimitiveRenderer.hpp"
-#include <random>
+#include "TileScheduler/TileScheduler.hpp"
+#include "WavefrontIntegrator/WavefrontIntegrator.hpp"
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
 namespace Raytracer {
 
+// Running mean of a pixel's samples and variance of their luminance,
+// updated one sample at a time with Welford's algorithm
+struct PixelEstimate {
+    int count = 0;
+    Math::Vector3D mean = Math::Vector3D(0, 0, 0);
+    double m2 = 0.0;
+    double meanLuminance = 0.0;
+
+    void add(const Math::Vector3D& sample)
+    {
+        double luminance = 0.2126 * sample.x + 0.7152 * sample.y + 0.0722 * sample.z;
+        count++;
+        mean += (sample - mean) / count;
+        double delta = luminance - meanLuminance;
+        meanLuminance += delta / count;
+        m2 += delta * (luminance - meanLuminance);
+    }
+
+    // Standard error of the mean luminance, infinite below two samples
+    double standardError() const
+    {
+        if (count < 2)
+            return std::numeric_limits<double>::infinity();
+        return std::sqrt(m2 / (count - 1) / count);
+    }
+};
+
+enum class RenderEngine {
+    Recursive, // Each camera ray is followed depth first, bounce by bounce
+    Wavefront, // Batches of rays move through the bounces together
+};
+
 class Renderer {
 private:
     SceneBuilder _scene;
@@ -25,29 +67,114 @@ private:
     int _height;
     int _maxDepth;
     int _samples;
+    int _threads;
     Math::Vector3D _backgroundColor;
     Timer renderTimer;
-    std::vector<std::string> renderResult;
+    FrameBuffer _frameBuffer;
+    std::string _outputPath;
+    ImageFormat _outputFormat;
+    std::function<void(const Tile&)> _tileCallback;
+    bool _progressive = false;
+    std::vector<PixelEstimate> _estimates;
+    double _adaptiveThreshold = 0.0;
+    std::function<void(int, int)> _passCallback;
+    std::atomic<bool> _stopRequested { false };
 
     std::unique_ptr<LightRenderer> _lightRenderer;
     std::unique_ptr<PrimitiveRenderer> _primitiveRenderer;
 
-    // Method for random numbers (for metal roughness)
-    double randomDouble(double min, double max)
-    {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        std::uniform_real_distribution<double> dis(min, max);
-        return dis(gen);
-    }
+    // Prototype cloned by every render thread, stratified by default
+    std::unique_ptr<ISampler> _sampler;
+    RenderEngine _engine = RenderEngine::Recursive;
+
+    // Camera samples a wavefront batch aims for
+    static constexpr int WAVEFRONT_BATCH = 4096;
+
+    void renderPass(int pass, int passes, std::atomic<int>& raysCast);
+    int renderTile(const Tile& tile, int pass, ISampler& sampler);
+    // Renders a tile one batch of camera samples at a time, returns the
+    // number of camera rays cast
+    int renderTileWavefront(const Tile& tile, int pass, ISampler& sampler,
+        WavefrontIntegrator& wavefront);
 
 public:
+    // Hands a render thread's sampler to the materials along with the way
+    // back into traceRay
+    class SampleTracer : public ITracer {
+    public:
+        SampleTracer(Renderer& renderer, ISampler& sampler,
+            double throughput = 1.0)
+            : _renderer(renderer)
+            , _sampler(sampler)
+            , _throughput(throughput)
+        {
+        }
+
+        Math::Vector3D trace(const Ray& ray, int depth, double weight) override;
+        ISampler& getSampler() override { return _sampler; }
+
+        // Probability that a branch with this throughput is followed, 0
+        // when it is dropped. Survivors are scaled by its inverse.
+        static double survival(double throughput, ISampler& sampler);
+
+    private:
+        // Below this share of the pixel a branch survives Russian roulette
+        // with probability weight / ROULETTE_WEIGHT
+        static constexpr double ROULETTE_WEIGHT = 0.1;
+
+        Renderer& _renderer;
+        ISampler& _sampler;
+        // Throughput from the camera to the ray being shaded
+        double _throughput;
+    };
+
+    // threads <= 0 uses every hardware thread
     Renderer(SceneBuilder scene, int width, int height, int maxDepth = 5,
-        int samples = 50);
+        int samples = 50, int threads = 0);
 
     void render();
-    Math::Vector3D traceRay(Ray& ray, int depth);
-    std::string drawPixel(const Math::Vector3D& color);
+    Math::Vector3D traceRay(const Ray& ray, int depth, ITracer& tracer);
+    Math::Vector3D samplePixel(int x, int y, int& raysCast, ISampler& sampler);
+    Math::Vector3D sampleAt(int x, int y, int sample, ISampler& sampler);
+    // Starts the sampler on the sample and places its ray on the pixel
+    Ray cameraRay(int x, int y, int sample, ISampler& sampler);
+    // The screen position cameraRay() shoots through, (0, 0) top left
+    void cameraPosition(int x, int y, int sample, ISampler& sampler, double& u,
+        double& v);
+    const Camera& getCamera() const { return _scene.getCamera(); }
+    int samplesPerPixel() const;
+    bool isConverged(const PixelEstimate& estimate) const;
+    void setOutput(const std::string& path, ImageFormat format);
+    // Writes the frame buffer to the configured output file
+    void save() const;
+
+    // Called from the render threads each time a tile of the frame buffer
+    // is final, so viewers can show the image while it is being rendered
+    void setTileCallback(std::function<void(const Tile&)> callback);
+    const FrameBuffer& getFrameBuffer() const { return _frameBuffer; }
+
+    // Progressive mode renders one sample per pixel per pass and keeps the
+    // running average in the frame buffer, so the image refines over time
+    void setProgressive(bool progressive);
+    // Called after each complete pass with (completed passes, total passes)
+    void setPassCallback(std::function<void(int, int)> callback);
+    // Thread-safe; render() returns once the tiles in flight are done. A
+    // stop is final: requested before render(), it keeps it from starting.
+    void stop();
+
+    // Adaptive sampling stops adding samples to a pixel once the standard
+    // error of its luminance drops below threshold; the supersampling grid
+    // stays the maximum budget. 0 disables it.
+    void setAdaptiveThreshold(double threshold);
+
+    // Renders are reproducible for a given sampler and seed, whatever the
+    // thread count
+    void setSampler(std::unique_ptr<ISampler> sampler);
+
+    // Both engines render the same image, the wavefront one shades hits
+    // grouped by material and traces shadow rays in batches
+    void setEngine(RenderEngine engine);
+    static RenderEngine engineFromName(const std::string& name);
 };
 
 } // namespace Raytracer
@@ -0,0 +1,134 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** TileScheduler.cpp
+*/
+#include "TileScheduler.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace Raytracer {
+
+namespace {
+
+    // Spreads the low 16 bits of v so that they occupy the even bits
+    std::uint32_t spreadBits(std::uint32_t v)
+    {
+        v &= 0x0000ffff;
+        v = (v | (v << 8)) & 0x00ff00ff;
+        v = (v | (v << 4)) & 0x0f0f0f0f;
+        v = (v | (v << 2)) & 0x33333333;
+        v = (v | (v << 1)) & 0x55555555;
+        return v;
+    }
+
+    std::uint32_t mortonCode(std::uint32_t x, std::uint32_t y)
+    {
+        return spreadBits(x) | (spreadBits(y) << 1);
+    }
+
+} // namespace
+
+TileScheduler::TileScheduler(int width, int height, int workerCount,
+    int tileSize)
+    : _workerCount(std::max(1, workerCount))
+{
+    if (width <= 0 || height <= 0 || tileSize <= 0)
+        throw std::invalid_argument("TileScheduler needs a positive image and tile size");
+
+    int tilesX = (width + tileSize - 1) / tileSize;
+    int tilesY = (height + tileSize - 1) / tileSize;
+    if (tilesX > 0xffff || tilesY > 0xffff)
+        throw std::invalid_argument("Image too large for its tile size");
+
+    std::vector<std::pair<std::uint32_t, Tile>> ordered;
+    ordered.reserve(static_cast<std::size_t>(tilesX) * tilesY);
+    for (int ty = 0; ty < tilesY; ty++) {
+        for (int tx = 0; tx < tilesX; tx++) {
+            Tile tile = { tx * tileSize, ty * tileSize,
+                std::min(width, (tx + 1) * tileSize),
+                std::min(height, (ty + 1) * tileSize) };
+            ordered.emplace_back(mortonCode(tx, ty), tile);
+        }
+    }
+    std::sort(ordered.begin(), ordered.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    _tiles.reserve(ordered.size());
+    for (const auto& entry : ordered)
+        _tiles.push_back(entry.second);
+
+    // Contiguous Morton runs keep each worker on a compact image region
+    _ranges = std::make_unique<Range[]>(_workerCount);
+    std::size_t count = _tiles.size();
+    for (int i = 0; i < _workerCount; i++) {
+        auto begin = static_cast<std::uint32_t>(count * i / _workerCount);
+        auto end = static_cast<std::uint32_t>(count * (i + 1) / _workerCount);
+        _ranges[i].bounds.store(pack(begin, end), std::memory_order_relaxed);
+    }
+}
+
+bool TileScheduler::next(int worker, Tile& tile)
+{
+    while (true) {
+        if (popOwn(worker, tile))
+            return true;
+        if (!steal(worker))
+            return false;
+    }
+}
+
+bool TileScheduler::popOwn(int worker, Tile& tile)
+{
+    std::atomic<std::uint64_t>& bounds = _ranges[worker].bounds;
+    std::uint64_t current = bounds.load(std::memory_order_acquire);
+
+    while (head(current) < tail(current)) {
+        std::uint64_t next = pack(head(current) + 1, tail(current));
+        if (bounds.compare_exchange_weak(current, next, std::memory_order_acq_rel,
+                std::memory_order_acquire)) {
+            tile = _tiles[head(current)];
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TileScheduler::steal(int worker)
+{
+    while (true) {
+        // Victim with the most work left: taking half of it halves the
+        // tail the slowest worker would otherwise finish alone
+        int victim = -1;
+        std::uint64_t victimBounds = 0;
+        std::uint32_t victimSize = 0;
+        for (int i = 0; i < _workerCount; i++) {
+            if (i == worker)
+                continue;
+            std::uint64_t bounds = _ranges[i].bounds.load(std::memory_order_acquire);
+            std::uint32_t size = tail(bounds) - head(bounds);
+            if (head(bounds) < tail(bounds) && size > victimSize) {
+                victim = i;
+                victimBounds = bounds;
+                victimSize = size;
+            }
+        }
+        if (victim < 0)
+            return false;
+
+        std::uint32_t taken = (victimSize + 1) / 2;
+        std::uint32_t split = tail(victimBounds) - taken;
+        if (_ranges[victim].bounds.compare_exchange_strong(victimBounds,
+                pack(head(victimBounds), split), std::memory_order_acq_rel,
+                std::memory_order_acquire)) {
+            // Only the owner refills its own empty range, so a plain store
+            // cannot clobber a concurrent thief
+            _ranges[worker].bounds.store(pack(split, tail(victimBounds)),
+                std::memory_order_release);
+            return true;
+        }
+    }
+}
+
+} // namespace Raytracer
@@ -0,0 +1,68 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** TileScheduler.hpp
+*/
+#ifndef TILE_SCHEDULER_HPP
+#define TILE_SCHEDULER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Raytracer {
+
+// Half-open pixel rectangle [x0, x1) x [y0, y1)
+struct Tile {
+    int x0;
+    int y0;
+    int x1;
+    int y1;
+};
+
+// Splits the image into small tiles laid out along a Morton curve and hands
+// each worker a contiguous run of them. A worker that runs dry steals half
+// of the largest remaining run, so expensive regions get spread over every
+// thread instead of stalling the one that owned them.
+class TileScheduler {
+public:
+    static constexpr int DEFAULT_TILE_SIZE = 16;
+
+    TileScheduler(int width, int height, int workerCount,
+        int tileSize = DEFAULT_TILE_SIZE);
+
+    // Fetches the next tile for a worker, false once the image is done
+    bool next(int worker, Tile& tile);
+
+    std::size_t getTileCount() const { return _tiles.size(); }
+    int getWorkerCount() const { return _workerCount; }
+
+private:
+    // Tile index range [head, tail) packed in one word so that the owner
+    // popping the front and thieves cutting the back race through a
+    // single compare-and-swap
+    struct alignas(64) Range {
+        std::atomic<std::uint64_t> bounds;
+    };
+
+    static std::uint64_t pack(std::uint32_t head, std::uint32_t tail)
+    {
+        return (static_cast<std::uint64_t>(head) << 32) | tail;
+    }
+    static std::uint32_t head(std::uint64_t bounds) { return static_cast<std::uint32_t>(bounds >> 32); }
+    static std::uint32_t tail(std::uint64_t bounds) { return static_cast<std::uint32_t>(bounds); }
+
+    bool popOwn(int worker, Tile& tile);
+    bool steal(int worker);
+
+    std::vector<Tile> _tiles;
+    int _workerCount;
+    std::unique_ptr<Range[]> _ranges;
+};
+
+} // namespace Raytracer
+
+#endif /* TILE_SCHEDULER_HPP */
@@ -0,0 +1,228 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** WavefrontIntegrator.cpp
+*/
+#include "WavefrontIntegrator.hpp"
+#include "../../material/IMaterial.hpp"
+#include "../Renderer.hpp"
+#include <algorithm>
+#include <typeinfo>
+
+namespace Raytracer {
+
+// Queues the rays a material asks for instead of tracing them. They are
+// traced with the next bounce, so the material only sees black and
+// returns the part of its color that does not depend on them.
+class WavefrontIntegrator::DeferredTracer : public ITracer {
+public:
+    DeferredTracer(const Path& path, const Math::Vector3D& light,
+        ISampler& sampler, std::vector<Path>& queue)
+        : _path(path)
+        , _light(light)
+        , _sampler(sampler)
+        , _queue(queue)
+    {
+    }
+
+    Math::Vector3D trace(const Ray& ray, int depth, double weight) override
+    {
+        double throughput = _path.weight * weight;
+        double survival = Renderer::SampleTracer::survival(throughput, _sampler);
+
+        if (survival > 0) {
+            // The material scales the color by weight and the renderer by
+            // the hit's light, on top of what the path already carries
+            Math::Vector3D factor = _path.throughput * _light * (weight / survival);
+            _queue.push_back({ ray, factor, throughput / survival, _path.slot,
+                depth, _sampler.getDimension() });
+        }
+        return Math::Vector3D(0, 0, 0);
+    }
+
+    ISampler& getSampler() override { return _sampler; }
+
+private:
+    const Path& _path;
+    const Math::Vector3D& _light;
+    ISampler& _sampler;
+    std::vector<Path>& _queue;
+};
+
+WavefrontIntegrator::WavefrontIntegrator(Renderer& renderer,
+    PrimitiveRenderer& primitiveRenderer,
+    const LightRenderer& lightRenderer,
+    const Math::Vector3D& backgroundColor, int maxDepth)
+    : _renderer(renderer)
+    , _primitiveRenderer(primitiveRenderer)
+    , _lightRenderer(lightRenderer)
+    , _backgroundColor(backgroundColor)
+    , _maxDepth(maxDepth)
+{
+}
+
+void WavefrontIntegrator::render(const std::vector<PixelSample>& samples,
+    std::vector<Math::Vector3D>& colors, ISampler& sampler)
+{
+    colors.assign(samples.size(), Math::Vector3D(0, 0, 0));
+
+    // Samples come in scanline order within a tile, so consecutive ones
+    // make coherent packets
+    _paths.clear();
+    _primary.resize((samples.size() + RayPacket::SIZE - 1) / RayPacket::SIZE);
+    for (std::size_t first = 0; first < samples.size(); first += RayPacket::SIZE) {
+        RayPacket& packet = _primary[first / RayPacket::SIZE];
+        int count = static_cast<int>(
+            std::min<std::size_t>(RayPacket::SIZE, samples.size() - first));
+        double u[RayPacket::SIZE];
+        double v[RayPacket::SIZE];
+        int dimension[RayPacket::SIZE];
+
+        for (int i = 0; i < count; i++) {
+            const PixelSample& s = samples[first + i];
+            _renderer.cameraPosition(s.x, s.y, s.sample, sampler, u[i], v[i]);
+            dimension[i] = sampler.getDimension();
+        }
+        _renderer.getCamera().rays(u, v, count, packet);
+        for (int i = 0; i < count; i++) {
+            _paths.push_back({ packet.ray(i), Math::Vector3D(1, 1, 1), 1.0,
+                first + i, 0, dimension[i] });
+        }
+    }
+
+    for (bool primary = true; !_paths.empty(); primary = false) {
+        if (primary)
+            intersectPrimary(colors);
+        else
+            intersect(colors);
+        traceShadows();
+        shade(samples, colors, sampler);
+        std::swap(_paths, _nextPaths);
+        _nextPaths.clear();
+    }
+}
+
+void WavefrontIntegrator::intersectPrimary(std::vector<Math::Vector3D>& colors)
+{
+    IPrimitive* primitives[RayPacket::SIZE];
+    IntersectionInfo intersections[RayPacket::SIZE];
+
+    _hits.clear();
+    for (std::size_t p = 0; p < _primary.size(); p++) {
+        const RayPacket& packet = _primary[p];
+
+        if (_maxDepth > 0) {
+            _primitiveRenderer.findClosestPacket(packet, primitives, intersections);
+        } else {
+            std::fill(primitives, primitives + RayPacket::SIZE, nullptr);
+        }
+        for (int i = 0; i < packet.count; i++) {
+            addHit(p * RayPacket::SIZE + i, primitives[i], intersections[i],
+                colors);
+        }
+    }
+}
+
+void WavefrontIntegrator::intersect(std::vector<Math::Vector3D>& colors)
+{
+    _hits.clear();
+    for (std::size_t i = 0; i < _paths.size(); i++) {
+        const Path& path = _paths[i];
+        IPrimitive* primitive = nullptr;
+        IntersectionInfo intersection;
+
+        if (path.depth < _maxDepth)
+            primitive = _primitiveRenderer.findClosestIntersection(path.ray, intersection);
+        addHit(i, primitive, intersection, colors);
+    }
+}
+
+void WavefrontIntegrator::addHit(std::size_t path, IPrimitive* primitive,
+    const IntersectionInfo& intersection, std::vector<Math::Vector3D>& colors)
+{
+    if (!primitive) {
+        colors[_paths[path].slot] += _paths[path].throughput * _backgroundColor;
+        return;
+    }
+
+    Hit hit;
+    hit.path = path;
+    hit.primitive = primitive;
+    hit.material = primitive->getMaterial();
+    hit.kind = typeid(*hit.material).hash_code();
+    hit.intersection = intersection;
+    _hits.push_back(hit);
+}
+
+void WavefrontIntegrator::traceShadows()
+{
+    _shadows.clear();
+    _shadowHits.clear();
+    for (std::size_t i = 0; i < _hits.size(); i++) {
+        Hit& hit = _hits[i];
+        hit.light = _lightRenderer.gatherLight(hit.intersection.hitPoint,
+            hit.primitive, hit.intersection.element, _shadows);
+        _shadowHits.resize(_shadows.size(), i);
+    }
+
+    for (std::size_t i = 0; i < _shadows.size(); i++) {
+        const ShadowQuery& query = _shadows[i];
+        if (!_primitiveRenderer.isOccluded(query.ray, query.maxDistance))
+            _hits[_shadowHits[i]].light += query.contribution;
+    }
+
+    for (Hit& hit : _hits)
+        hit.light = LightRenderer::clampLight(hit.light);
+}
+
+void WavefrontIntegrator::shade(const std::vector<PixelSample>& samples,
+    std::vector<Math::Vector3D>& colors, ISampler& sampler)
+{
+    // Runs of hits on the same material type keep its shading code hot. A
+    // counting sort over the few types in the batch is stable, so the paths
+    // of a run stay in order and the sums round the same way every render.
+    _kinds.clear();
+    for (const Hit& hit : _hits) {
+        auto kind = std::find_if(_kinds.begin(), _kinds.end(),
+            [&](const auto& entry) { return entry.first == hit.kind; });
+        if (kind == _kinds.end())
+            _kinds.emplace_back(hit.kind, 1);
+        else
+            kind->second++;
+    }
+    std::size_t offset = 0;
+    for (auto& [_, count] : _kinds) {
+        std::size_t size = count;
+        count = offset;
+        offset += size;
+    }
+    _order.resize(_hits.size());
+    for (std::size_t i = 0; i < _hits.size(); i++) {
+        auto kind = std::find_if(_kinds.begin(), _kinds.end(),
+            [&](const auto& entry) { return entry.first == _hits[i].kind; });
+        _order[kind->second++] = i;
+    }
+
+    for (std::size_t index : _order) {
+        const Hit& hit = _hits[index];
+        const Path& path = _paths[hit.path];
+        const PixelSample& s = samples[path.slot];
+        Math::Vector3D color;
+
+        sampler.startSample(s.x, s.y, s.sample);
+        sampler.setDimension(path.dimension);
+        if (hit.material->isLinear()) {
+            DeferredTracer tracer(path, hit.light, sampler, _nextPaths);
+            color = hit.material->computeInteraction(path.ray, hit.intersection,
+                tracer, path.depth);
+        } else {
+            Renderer::SampleTracer tracer(_renderer, sampler, path.weight);
+            color = hit.material->computeInteraction(path.ray, hit.intersection,
+                tracer, path.depth);
+        }
+        colors[path.slot] += path.throughput * hit.light * color;
+    }
+}
+
+} // namespace Raytracer
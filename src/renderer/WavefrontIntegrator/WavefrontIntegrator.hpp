@@ -0,0 +1,108 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** WavefrontIntegrator.hpp
+*/
+#ifndef WAVEFRONT_INTEGRATOR_HPP
+#define WAVEFRONT_INTEGRATOR_HPP
+
+#include "../../core/Ray.hpp"
+#include "../../core/RayPacket.hpp"
+#include "../../core/Vector3D.hpp"
+#include "../../interfaces/IMaterialInteraction.hpp"
+#include "../../interfaces/IPrimitive.hpp"
+#include "../../interfaces/ISampler.hpp"
+#include "../LightRenderer/LightRenderer.hpp"
+#include "../PrimitiveRenderer/PrimitiveRenderer.hpp"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace Raytracer {
+
+class IMaterial;
+class Renderer;
+
+// One camera sample of a batch
+struct PixelSample {
+    int x;
+    int y;
+    int sample;
+};
+
+// Renders batches of camera samples breadth first: all the rays of a
+// bounce are intersected (camera rays as packets of neighbouring
+// samples), then their shadow rays are traced, then the hits are shaded
+// grouped by material, which queues the next bounce. A material shades a
+// hit before its secondary rays are traced and their colors are added to
+// the pixel later, weighted by the path's throughput. One integrator per
+// render thread, it keeps its queues between batches.
+class WavefrontIntegrator {
+public:
+    WavefrontIntegrator(Renderer& renderer,
+        PrimitiveRenderer& primitiveRenderer,
+        const LightRenderer& lightRenderer,
+        const Math::Vector3D& backgroundColor, int maxDepth);
+
+    // colors[i] receives the color of samples[i]
+    void render(const std::vector<PixelSample>& samples,
+        std::vector<Math::Vector3D>& colors, ISampler& sampler);
+
+private:
+    // A ray waiting to be traced and what its color is worth to the pixel
+    struct Path {
+        Ray ray;
+        Math::Vector3D throughput;
+        // Scalar throughput driving pruning and Russian roulette, the same
+        // one the recursive engine tracks
+        double weight;
+        std::size_t slot;
+        int depth;
+        int dimension;
+    };
+
+    struct Hit {
+        std::size_t path;
+        IPrimitive* primitive;
+        const IMaterial* material;
+        // Sort key grouping the hits of a material type together
+        std::size_t kind;
+        IntersectionInfo intersection;
+        Math::Vector3D light;
+    };
+
+    class DeferredTracer;
+
+    void intersectPrimary(std::vector<Math::Vector3D>& colors);
+    void intersect(std::vector<Math::Vector3D>& colors);
+    void addHit(std::size_t path, IPrimitive* primitive,
+        const IntersectionInfo& intersection,
+        std::vector<Math::Vector3D>& colors);
+    void traceShadows();
+    void shade(const std::vector<PixelSample>& samples,
+        std::vector<Math::Vector3D>& colors, ISampler& sampler);
+
+    Renderer& _renderer;
+    PrimitiveRenderer& _primitiveRenderer;
+    const LightRenderer& _lightRenderer;
+    Math::Vector3D _backgroundColor;
+    int _maxDepth;
+
+    // Camera rays of the batch, RayPacket::SIZE paths per packet
+    std::vector<RayPacket> _primary;
+    std::vector<Path> _paths;
+    std::vector<Path> _nextPaths;
+    std::vector<Hit> _hits;
+    std::vector<ShadowQuery> _shadows;
+    // Hit lit by each shadow query
+    std::vector<std::size_t> _shadowHits;
+    // Material types of the bounce with their hit counts, then offsets
+    std::vector<std::pair<std::size_t, std::size_t>> _kinds;
+    // Hits in shading order
+    std::vector<std::size_t> _order;
+};
+
+} // namespace Raytracer
+
+#endif /* WAVEFRONT_INTEGRATOR_HPP */
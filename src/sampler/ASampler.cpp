@@ -0,0 +1,97 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** ASampler.cpp
+*/
+#include "ASampler.hpp"
+
+namespace Raytracer {
+
+ASampler::ASampler(std::uint64_t seed)
+    : _seed(seed)
+{
+}
+
+void ASampler::startSample(int x, int y, int sample)
+{
+    std::uint64_t pixel = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(y)) << 32)
+        | static_cast<std::uint32_t>(x);
+    _pixelKey = mix(pixel ^ mix(_seed));
+    _sample = static_cast<std::uint32_t>(sample);
+    _dimension = 0;
+}
+
+Sample2D ASampler::next2D()
+{
+    double u = next1D();
+    return { u, next1D() };
+}
+
+int ASampler::getDimension() const
+{
+    return _dimension;
+}
+
+void ASampler::setDimension(int dimension)
+{
+    _dimension = dimension;
+}
+
+std::uint64_t ASampler::mix(std::uint64_t v)
+{
+    v = (v ^ (v >> 30)) * 0xbf58476d1ce4e5b9ull;
+    v = (v ^ (v >> 27)) * 0x94d049bb133111ebull;
+    return v ^ (v >> 31);
+}
+
+std::uint32_t ASampler::permute(std::uint32_t i, std::uint32_t length, std::uint32_t seed)
+{
+    std::uint32_t w = length - 1;
+    w |= w >> 1;
+    w |= w >> 2;
+    w |= w >> 4;
+    w |= w >> 8;
+    w |= w >> 16;
+
+    // Cycle-walking: hash inside the enclosing power of two until the
+    // result lands back in range
+    do {
+        i ^= seed;
+        i *= 0xe170893du;
+        i ^= seed >> 16;
+        i ^= (i & w) >> 4;
+        i ^= seed >> 8;
+        i *= 0x0929eb3fu;
+        i ^= seed >> 23;
+        i ^= (i & w) >> 1;
+        i *= 1 | seed >> 27;
+        i *= 0x6935fa69u;
+        i ^= (i & w) >> 11;
+        i *= 0x74dcb303u;
+        i ^= (i & w) >> 2;
+        i *= 0x9e501cc3u;
+        i ^= (i & w) >> 2;
+        i *= 0xc860a3dfu;
+        i &= w;
+        i ^= i >> 5;
+    } while (i >= length);
+    return (i + seed) % length;
+}
+
+double ASampler::toUnit(std::uint64_t bits)
+{
+    return (bits >> 11) * 0x1p-53;
+}
+
+std::uint32_t ASampler::dimensionSeed(int dimension) const
+{
+    return static_cast<std::uint32_t>(mix(_pixelKey + static_cast<std::uint64_t>(dimension)));
+}
+
+std::uint64_t ASampler::sampleHash(int dimension) const
+{
+    return mix(mix(_pixelKey + static_cast<std::uint64_t>(dimension)) ^ _sample);
+}
+
+} // namespace Raytracer
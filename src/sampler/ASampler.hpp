@@ -0,0 +1,50 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** ASampler.hpp
+*/
+#ifndef ASAMPLER_HPP
+#define ASAMPLER_HPP
+
+#include "../interfaces/ISampler.hpp"
+#include <cstdint>
+
+namespace Raytracer {
+
+// Keeps track of the current pixel, sample index and dimension, and holds
+// the hashing helpers the samplers use to decorrelate pixels
+class ASampler : public ISampler {
+public:
+    explicit ASampler(std::uint64_t seed);
+
+    void startSample(int x, int y, int sample) override;
+    Sample2D next2D() override;
+    int getDimension() const override;
+    void setDimension(int dimension) override;
+
+protected:
+    // Largest double below 1, rounded sums are clamped to it
+    static constexpr double ONE_MINUS_EPSILON = 0x1.fffffffffffffp-1;
+
+    // SplitMix64 finalizer
+    static std::uint64_t mix(std::uint64_t v);
+    // Random permutation of [0, length) selected by seed, Kensler's
+    // "Correlated Multi-Jittered Sampling"
+    static std::uint32_t permute(std::uint32_t i, std::uint32_t length, std::uint32_t seed);
+    static double toUnit(std::uint64_t bits);
+
+    // Same for every sample of the current pixel, different per dimension
+    std::uint32_t dimensionSeed(int dimension) const;
+    // Also different for every sample
+    std::uint64_t sampleHash(int dimension) const;
+
+    std::uint64_t _seed;
+    std::uint64_t _pixelKey = 0;
+    std::uint32_t _sample = 0;
+    int _dimension = 0;
+};
+
+} // namespace Raytracer
+
+#endif /* ASAMPLER_HPP */
@@ -0,0 +1,60 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** HaltonSampler.cpp
+*/
+#include "HaltonSampler.hpp"
+#include <algorithm>
+#include <array>
+
+namespace Raytracer {
+
+namespace {
+
+    // Higher bases need too many samples before their points spread out,
+    // dimensions past the table fall back to random values
+    constexpr std::array<std::uint32_t, 32> PRIMES = {
+        2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53,
+        59, 61, 67, 71, 73, 79, 83, 89, 97, 101, 103, 107, 109, 113, 127, 131
+    };
+
+} // namespace
+
+HaltonSampler::HaltonSampler(std::uint64_t seed)
+    : ASampler(seed)
+{
+}
+
+double HaltonSampler::next1D()
+{
+    int dimension = _dimension++;
+    if (dimension >= static_cast<int>(PRIMES.size()))
+        return toUnit(sampleHash(dimension));
+    return scrambledRadicalInverse(PRIMES[dimension], _sample, dimensionSeed(dimension));
+}
+
+std::unique_ptr<ISampler> HaltonSampler::clone() const
+{
+    return std::make_unique<HaltonSampler>(*this);
+}
+
+double HaltonSampler::scrambledRadicalInverse(std::uint32_t base,
+    std::uint32_t index, std::uint32_t seed) const
+{
+    const double invBase = 1.0 / base;
+    double weight = invBase;
+    double result = 0.0;
+
+    // The leading zero digits are shifted too, so keep going until the
+    // digits no longer change the double
+    for (std::uint32_t digitIndex = 0; weight > 0x1p-40; digitIndex++) {
+        std::uint32_t shift = static_cast<std::uint32_t>(mix(seed + (static_cast<std::uint64_t>(digitIndex) << 32)) % base);
+        result += ((index % base + shift) % base) * weight;
+        index /= base;
+        weight *= invBase;
+    }
+    return std::min(result, ONE_MINUS_EPSILON);
+}
+
+} // namespace Raytracer
@@ -0,0 +1,31 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** HaltonSampler.hpp
+*/
+#ifndef HALTON_SAMPLER_HPP
+#define HALTON_SAMPLER_HPP
+
+#include "ASampler.hpp"
+
+namespace Raytracer {
+
+// Halton sequence indexed by the sample number, one prime base per
+// dimension. Each pixel scrambles the digits with its own random shifts so
+// that neighbouring pixels do not share the same points.
+class HaltonSampler : public ASampler {
+public:
+    explicit HaltonSampler(std::uint64_t seed = 0);
+
+    double next1D() override;
+    std::unique_ptr<ISampler> clone() const override;
+
+private:
+    double scrambledRadicalInverse(std::uint32_t base, std::uint32_t index,
+        std::uint32_t seed) const;
+};
+
+} // namespace Raytracer
+
+#endif /* HALTON_SAMPLER_HPP */
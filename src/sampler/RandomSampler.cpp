@@ -0,0 +1,72 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** RandomSampler.cpp
+*/
+#include "RandomSampler.hpp"
+
+namespace Raytracer {
+
+RandomSampler::RandomSampler(std::uint64_t seed)
+    : ASampler(seed)
+{
+    startSample(0, 0, 0);
+}
+
+void RandomSampler::startSample(int x, int y, int sample)
+{
+    ASampler::startSample(x, y, sample);
+    std::uint64_t key = sampleHash(0);
+
+    // Standard PCG32 seeding, the stream selector must be odd
+    _state = 0;
+    _increment = (mix(key) << 1) | 1;
+    nextUInt();
+    _state += key;
+    nextUInt();
+    _startState = _state;
+}
+
+double RandomSampler::next1D()
+{
+    _dimension++;
+    return nextUInt() * 0x1p-32;
+}
+
+void RandomSampler::setDimension(int dimension)
+{
+    // Jumps the LCG ahead in O(log n) steps, Brown's "Random Number
+    // Generation with Arbitrary Strides"
+    std::uint64_t multiplier = 6364136223846793005ull;
+    std::uint64_t increment = _increment;
+    std::uint64_t accMultiplier = 1;
+    std::uint64_t accIncrement = 0;
+
+    for (auto steps = static_cast<std::uint64_t>(dimension); steps > 0; steps >>= 1) {
+        if (steps & 1) {
+            accMultiplier *= multiplier;
+            accIncrement = accIncrement * multiplier + increment;
+        }
+        increment = (multiplier + 1) * increment;
+        multiplier *= multiplier;
+    }
+    _state = accMultiplier * _startState + accIncrement;
+    _dimension = dimension;
+}
+
+std::unique_ptr<ISampler> RandomSampler::clone() const
+{
+    return std::make_unique<RandomSampler>(*this);
+}
+
+std::uint32_t RandomSampler::nextUInt()
+{
+    std::uint64_t old = _state;
+    _state = old * 6364136223846793005ull + _increment;
+    auto shifted = static_cast<std::uint32_t>(((old >> 18) ^ old) >> 27);
+    auto rotation = static_cast<std::uint32_t>(old >> 59);
+    return (shifted >> rotation) | (shifted << ((32 - rotation) & 31));
+}
+
+} // namespace Raytracer
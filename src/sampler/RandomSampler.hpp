@@ -0,0 +1,36 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** RandomSampler.hpp
+*/
+#ifndef RANDOM_SAMPLER_HPP
+#define RANDOM_SAMPLER_HPP
+
+#include "ASampler.hpp"
+
+namespace Raytracer {
+
+// Independent uniform samples from a PCG32 generator whose stream is
+// derived from the pixel and sample index
+class RandomSampler : public ASampler {
+public:
+    explicit RandomSampler(std::uint64_t seed = 0);
+
+    void startSample(int x, int y, int sample) override;
+    double next1D() override;
+    void setDimension(int dimension) override;
+    std::unique_ptr<ISampler> clone() const override;
+
+private:
+    std::uint32_t nextUInt();
+
+    std::uint64_t _state = 0;
+    // State right after seeding, where dimension 0 starts
+    std::uint64_t _startState = 0;
+    std::uint64_t _increment = 1;
+};
+
+} // namespace Raytracer
+
+#endif /* RANDOM_SAMPLER_HPP */
@@ -0,0 +1,82 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** SobolSampler.cpp
+*/
+#include "SobolSampler.hpp"
+
+namespace Raytracer {
+
+SobolSampler::SobolSampler(std::uint64_t seed)
+    : ASampler(seed)
+{
+}
+
+double SobolSampler::next1D()
+{
+    int dimension = _dimension++;
+    std::uint32_t seed = dimensionSeed(dimension);
+    std::uint32_t index = nestedUniformScramble(_sample, seed);
+    std::uint32_t value = nestedUniformScramble(reverseBits(index), static_cast<std::uint32_t>(mix(seed)));
+
+    return value * 0x1p-32;
+}
+
+Sample2D SobolSampler::next2D()
+{
+    int dimension = _dimension;
+    _dimension += 2;
+
+    // Shuffling the index keeps the (0, 2) stratification of every
+    // power-of-two prefix while decorrelating the dimension pairs
+    std::uint32_t seed = dimensionSeed(dimension);
+    std::uint32_t index = nestedUniformScramble(_sample, seed);
+    std::uint32_t u = reverseBits(index);
+    std::uint32_t v = sobolSecondDimension(index);
+
+    std::uint64_t scramble = mix(seed);
+    u = nestedUniformScramble(u, static_cast<std::uint32_t>(scramble));
+    v = nestedUniformScramble(v, static_cast<std::uint32_t>(scramble >> 32));
+    return { u * 0x1p-32, v * 0x1p-32 };
+}
+
+std::unique_ptr<ISampler> SobolSampler::clone() const
+{
+    return std::make_unique<SobolSampler>(*this);
+}
+
+std::uint32_t SobolSampler::reverseBits(std::uint32_t x)
+{
+    x = (x << 16) | (x >> 16);
+    x = ((x & 0x00ff00ffu) << 8) | ((x & 0xff00ff00u) >> 8);
+    x = ((x & 0x0f0f0f0fu) << 4) | ((x & 0xf0f0f0f0u) >> 4);
+    x = ((x & 0x33333333u) << 2) | ((x & 0xccccccccu) >> 2);
+    x = ((x & 0x55555555u) << 1) | ((x & 0xaaaaaaaau) >> 1);
+    return x;
+}
+
+std::uint32_t SobolSampler::sobolSecondDimension(std::uint32_t index)
+{
+    std::uint32_t result = 0;
+    for (std::uint32_t v = 1u << 31; index != 0; index >>= 1, v ^= v >> 1) {
+        if (index & 1)
+            result ^= v;
+    }
+    return result;
+}
+
+std::uint32_t SobolSampler::nestedUniformScramble(std::uint32_t x, std::uint32_t seed)
+{
+    // Laine-Karras style hash: each bit only depends on the bits below it,
+    // which on reversed bits gives an Owen scramble
+    x = reverseBits(x);
+    x ^= x * 0x3d20adeau;
+    x += seed;
+    x *= (seed >> 16) | 1;
+    x ^= x * 0x05526c56u;
+    x ^= x * 0x53a22864u;
+    return reverseBits(x);
+}
+
+} // namespace Raytracer
@@ -0,0 +1,33 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** SobolSampler.hpp
+*/
+#ifndef SOBOL_SAMPLER_HPP
+#define SOBOL_SAMPLER_HPP
+
+#include "ASampler.hpp"
+
+namespace Raytracer {
+
+// Owen-scrambled 2D Sobol points, padded across dimensions: every pair of
+// dimensions draws from its own shuffle of the (0, 2) sequence, as in
+// Burley's "Practical Hash-based Owen Scrambling"
+class SobolSampler : public ASampler {
+public:
+    explicit SobolSampler(std::uint64_t seed = 0);
+
+    double next1D() override;
+    Sample2D next2D() override;
+    std::unique_ptr<ISampler> clone() const override;
+
+private:
+    static std::uint32_t reverseBits(std::uint32_t x);
+    static std::uint32_t sobolSecondDimension(std::uint32_t index);
+    static std::uint32_t nestedUniformScramble(std::uint32_t x, std::uint32_t seed);
+};
+
+} // namespace Raytracer
+
+#endif /* SOBOL_SAMPLER_HPP */
@@ -0,0 +1,51 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** StratifiedSampler.cpp
+*/
+#include "StratifiedSampler.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace Raytracer {
+
+StratifiedSampler::StratifiedSampler(int samplesPerPixel, std::uint64_t seed)
+    : ASampler(seed)
+    , _strata(static_cast<std::uint32_t>(std::max(1, samplesPerPixel)))
+{
+    _gridSize = static_cast<std::uint32_t>(std::lround(std::sqrt(_strata)));
+    if (_gridSize * _gridSize != _strata)
+        _gridSize = 0;
+}
+
+double StratifiedSampler::next1D()
+{
+    int dimension = _dimension++;
+    std::uint32_t stratum = permute(_sample % _strata, _strata, dimensionSeed(dimension));
+
+    return std::min((stratum + toUnit(sampleHash(dimension))) / _strata, ONE_MINUS_EPSILON);
+}
+
+Sample2D StratifiedSampler::next2D()
+{
+    if (_gridSize == 0) {
+        double u = next1D();
+        return { u, next1D() };
+    }
+
+    int dimension = _dimension;
+    _dimension += 2;
+    std::uint32_t cell = permute(_sample % _strata, _strata, dimensionSeed(dimension));
+    std::uint64_t jitter = sampleHash(dimension);
+
+    return { std::min((cell % _gridSize + toUnit(jitter)) / _gridSize, ONE_MINUS_EPSILON),
+        std::min((cell / _gridSize + toUnit(mix(jitter))) / _gridSize, ONE_MINUS_EPSILON) };
+}
+
+std::unique_ptr<ISampler> StratifiedSampler::clone() const
+{
+    return std::make_unique<StratifiedSampler>(*this);
+}
+
+} // namespace Raytracer
@@ -0,0 +1,32 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** StratifiedSampler.hpp
+*/
+#ifndef STRATIFIED_SAMPLER_HPP
+#define STRATIFIED_SAMPLER_HPP
+
+#include "ASampler.hpp"
+
+namespace Raytracer {
+
+// Jittered strata: over samplesPerPixel samples every dimension hits each
+// of its strata exactly once, in a per-pixel random order. 2D requests use
+// a square grid when the count allows it, Latin hypercube otherwise.
+class StratifiedSampler : public ASampler {
+public:
+    explicit StratifiedSampler(int samplesPerPixel, std::uint64_t seed = 0);
+
+    double next1D() override;
+    Sample2D next2D() override;
+    std::unique_ptr<ISampler> clone() const override;
+
+private:
+    std::uint32_t _strata;
+    std::uint32_t _gridSize;
+};
+
+} // namespace Raytracer
+
+#endif /* STRATIFIED_SAMPLER_HPP */
@@ -17,10 +17,9 @@
 #include <SFML/System/Vector2.hpp>
 #include <SFML/Window/VideoMode.hpp>
 #include <filesystem>
-#include <fstream>
 #include <future>
+#include <iostream>
 #include <memory>
-#include <sstream>
 #include <stdexcept>
 
 namespace Interface {
@@ -31,6 +30,13 @@ DisplayManager::DisplayManager()
       {"refraction", "0"}, {"superSampling", "0"}, {"sceneFile", "NONE"}};
 }
 
+DisplayManager::~DisplayManager() {
+  // The render task uses our members, let it finish before they go away
+  stopRender();
+  if (_renderFuture.valid())
+    _renderFuture.wait();
+}
+
 std::shared_ptr<sf::RectangleShape>
 DisplayManager::getElement(const std::string &name) {
   auto it = _elements.find(name);
@@ -110,6 +116,8 @@ void DisplayManager::init() {
   _superSamplingText = setupText("s: " + _selectedParams["superSampling"],
                                  getElement("params"), 50.0f, 10.0f);
 
+  _passText = setupText("", getElement("params"), 60.0f, 10.0f);
+
   float yOffset = 2.f;
 
   for (const auto &entry : std::filesystem::directory_iterator("scenes")) {
@@ -133,94 +141,150 @@ void DisplayManager::display() {
 
 void DisplayManager::renderScene(const std::string &sceneFile) {
   if (_isRendering) {
+    // A new selection replaces the render in progress
+    stopRender();
     if (_renderFuture.valid()) {
       _renderFuture.wait();
     }
   }
 
-  _isRendering = true;
-
-  int superSampling = std::stoi(_selectedParams["superSampling"]);
-  int refraction = std::stoi(_selectedParams["refraction"]);
-
-  _renderFuture = std::async(
-      std::launch::async, [this, sceneFile, superSampling, refraction]() {
-        auto screenElement = getElement("screen");
-
-        int width = static_cast<int>(screenElement->getSize().x);
-        int height = static_cast<int>(screenElement->getSize().y);
-
-        Raytracer::SceneBuilder builder;
-        Raytracer::SceneLoader loader(builder);
-        loader.loadSceneFromFile("scenes/" + sceneFile);
-
-        Raytracer::Renderer renderer(std::move(builder), width, height,
-                                     refraction + 1, superSampling);
-        renderer.render();
-      });
-}
-
-sf::Image loadPPM(const std::string &filePath) {
-  std::ifstream file(filePath);
-  if (!file)
-    throw std::runtime_error("Failed to open PPM file: " + filePath);
-
-  std::string format;
-  file >> format;
-  if (format != "P3")
-    throw std::runtime_error("Invalid PPM format. Expected P3, got " + format);
-
-  int width, height, maxVal;
-  file >> width >> height >> maxVal;
+  auto screenElement = getElement("screen");
+  if (!screenElement)
+    throw std::runtime_error("Screen element not found");
 
-  if (width <= 0 || height <= 0)
-    throw std::runtime_error("Invalid image dimensions");
+  int width = static_cast<int>(screenElement->getSize().x);
+  int height = static_cast<int>(screenElement->getSize().y);
 
-  std::vector<sf::Uint8> pixels(width * height * 4);
+  // Start from a black texture that tiles get pasted into as they finish
+  if (!_renderedTexture.create(width, height))
+    throw std::runtime_error("Failed to create render texture.");
+  std::vector<sf::Uint8> blank(width * height * 4, 0);
+  for (std::size_t i = 3; i < blank.size(); i += 4)
+    blank[i] = 255;
+  _renderedTexture.update(blank.data());
+  screenElement->setTexture(&_renderedTexture, true);
 
-  for (int i = 0; i < width * height; ++i) {
-    int r, g, b;
+  {
+    std::lock_guard<std::mutex> lock(_tileMutex);
+    _pendingTiles.clear();
+  }
 
-    file >> r >> g >> b;
-    pixels[i * 4 + 0] = static_cast<sf::Uint8>(r);
-    pixels[i * 4 + 1] = static_cast<sf::Uint8>(g);
-    pixels[i * 4 + 2] = static_cast<sf::Uint8>(b);
-    pixels[i * 4 + 3] = 255;
+  {
+    std::lock_guard<std::mutex> lock(_rendererMutex);
+    _stopPending = false;
   }
+  _isRendering = true;
+  _completedPasses = 0;
+  _totalPasses = 0;
 
-  sf::Image image;
-  image.create(width, height, pixels.data());
+  int superSampling = std::stoi(_selectedParams["superSampling"]);
+  int refraction = std::stoi(_selectedParams["refraction"]);
 
-  return image;
+  _renderFuture = std::async(std::launch::async, [this, sceneFile,
+                                                  superSampling, refraction,
+                                                  width, height]() {
+    {
+      std::lock_guard<std::mutex> lock(_rendererMutex);
+      if (_stopPending)
+        return;
+    }
+    Raytracer::SceneBuilder builder;
+    Raytracer::SceneLoader loader(builder);
+    loader.loadSceneFromFile("scenes/" + sceneFile);
+
+    Raytracer::Renderer renderer(std::move(builder), width, height,
+                                 refraction + 1, superSampling);
+    renderer.setTileCallback([this, &renderer](const Raytracer::Tile &tile) {
+      queueTile(renderer.getFrameBuffer(), tile);
+    });
+    renderer.setProgressive(true);
+    renderer.setPassCallback([this](int completed, int total) {
+      _completedPasses = completed;
+      _totalPasses = total;
+    });
+
+    {
+      std::lock_guard<std::mutex> lock(_rendererMutex);
+      if (_stopPending)
+        renderer.stop();
+      _activeRenderer = &renderer;
+    }
+    try {
+      renderer.render();
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(_rendererMutex);
+      _activeRenderer = nullptr;
+      throw;
+    }
+    std::lock_guard<std::mutex> lock(_rendererMutex);
+    _activeRenderer = nullptr;
+  });
 }
 
-void DisplayManager::loadRenderToScreen() {
-  if (!_win.isOpen())
-    return;
-
-  if (!std::filesystem::exists("output.ppm"))
-    throw std::runtime_error("Output file not found");
+void DisplayManager::stopRender() {
+  std::lock_guard<std::mutex> lock(_rendererMutex);
+  _stopPending = true;
+  if (_activeRenderer)
+    _activeRenderer->stop();
+}
 
-  sf::Image ppmImage = loadPPM("output.ppm");
+void DisplayManager::queueTile(const Raytracer::FrameBuffer &image,
+                               const Raytracer::Tile &tile) {
+  PendingTile pending{tile, {}};
+  pending.pixels.reserve((tile.x1 - tile.x0) * (tile.y1 - tile.y0) * 4);
+
+  for (int y = tile.y0; y < tile.y1; y++) {
+    const float *row = image.row(y);
+    for (int x = tile.x0; x < tile.x1; x++) {
+      pending.pixels.push_back(Raytracer::FrameBuffer::toByte(row[3 * x]));
+      pending.pixels.push_back(Raytracer::FrameBuffer::toByte(row[3 * x + 1]));
+      pending.pixels.push_back(Raytracer::FrameBuffer::toByte(row[3 * x + 2]));
+      pending.pixels.push_back(255);
+    }
+  }
 
-  auto screenElement = getElement("screen");
-  if (!screenElement)
-    throw std::runtime_error("Screen element not found");
+  std::lock_guard<std::mutex> lock(_tileMutex);
+  _pendingTiles.push_back(std::move(pending));
+}
 
-  if (!_renderedTexture.loadFromImage(ppmImage))
-    throw std::runtime_error("Failed to create texture from image.");
+void DisplayManager::uploadPendingTiles() {
+  std::vector<PendingTile> tiles;
+  {
+    std::lock_guard<std::mutex> lock(_tileMutex);
+    tiles.swap(_pendingTiles);
+  }
 
-  screenElement->setTexture(&_renderedTexture, true);
+  // Textures belong to the UI thread's GL context, so uploads happen here
+  for (const auto &tile : tiles) {
+    _renderedTexture.update(tile.pixels.data(), tile.area.x1 - tile.area.x0,
+                            tile.area.y1 - tile.area.y0, tile.area.x0,
+                            tile.area.y0);
+  }
 }
+
 void DisplayManager::update() {
   _superSamplingText.setString("s: " + _selectedParams["superSampling"]);
   _refractionText.setString("r: " + _selectedParams["refraction"]);
+  if (_totalPasses > 0)
+    _passText.setString("p: " + std::to_string(_completedPasses) + "/" +
+                        std::to_string(_totalPasses));
+
+  if (!_isRendering)
+    return;
 
-  if (_isRendering && _renderFuture.valid() &&
-      _renderFuture.wait_for(std::chrono::seconds(0)) ==
-          std::future_status::ready) {
-    loadRenderToScreen();
+  bool finished = _renderFuture.valid() &&
+                  _renderFuture.wait_for(std::chrono::seconds(0)) ==
+                      std::future_status::ready;
+
+  // Checked before uploading so the last tiles are not left behind
+  uploadPendingTiles();
+  if (finished) {
     _isRendering = false;
+    try {
+      _renderFuture.get();
+    } catch (const std::exception &e) {
+      std::cerr << "Render failed: " << e.what() << std::endl;
+    }
   }
 }
 
@@ -241,6 +305,7 @@ void DisplayManager::draw() {
 
   _win.draw(_refractionText);
   _win.draw(_superSamplingText);
+  _win.draw(_passText);
 }
 
 sf::RenderWindow &DisplayManager::getWindow() { return _win; }
@@ -7,13 +7,22 @@
 #ifndef DISPLAY_MANAGER_HPP
 #define DISPLAY_MANAGER_HPP
 
+#include "../renderer/FrameBuffer/FrameBuffer.hpp"
+#include "../renderer/TileScheduler/TileScheduler.hpp"
 #include <SFML/Graphics.hpp>
 #include <SFML/Graphics/RectangleShape.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
+#include <atomic>
 #include <future>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
+
+namespace Raytracer {
+class Renderer;
+}
 
 namespace Interface {
 
@@ -40,6 +49,13 @@ class DisplayManager {
     int a;
   };
 
+  // Finished tile converted to RGBA by a render thread, waiting for the UI
+  // thread to upload it to the texture
+  struct PendingTile {
+    Raytracer::Tile area;
+    std::vector<sf::Uint8> pixels;
+  };
+
 private:
   sf::RenderWindow _win;
 
@@ -51,6 +67,7 @@ private:
   int _highlightedSceneIndex = -1;
   sf::Text _refractionText;
   sf::Text _superSamplingText;
+  sf::Text _passText;
 
   std::unordered_map<std::string, std::string> _selectedParams;
 
@@ -65,11 +82,23 @@ private:
                      float xPercent, float yPercent);
 
   sf::Texture _renderedTexture;
+  std::mutex _tileMutex;
+  std::vector<PendingTile> _pendingTiles;
   std::future<void> _renderFuture;
   bool _isRendering = false;
 
+  // Renderer running on _renderFuture, only valid while it renders
+  std::mutex _rendererMutex;
+  Raytracer::Renderer *_activeRenderer = nullptr;
+  // Stop requested while the scene is still loading, before there is a
+  // renderer to stop. Guarded by _rendererMutex.
+  bool _stopPending = false;
+  std::atomic<int> _completedPasses{0};
+  std::atomic<int> _totalPasses{0};
+
 public:
   DisplayManager();
+  ~DisplayManager();
 
   void init();
   void display();
@@ -82,7 +111,10 @@ public:
   void highlightScene(int index);
   void setSelectedParam(const std::string &key, const std::string &value);
   void renderScene(const std::string &sceneFile);
-  void loadRenderToScreen();
+  void stopRender();
+  void queueTile(const Raytracer::FrameBuffer &image,
+                 const Raytracer::Tile &tile);
+  void uploadPendingTiles();
 };
 
 } // namespace Interface
@@ -31,6 +31,9 @@ void EventManager::handleEvents() {
       case sf::Keyboard::Right:
         incrementParam("superSampling");
         break;
+      case sf::Keyboard::Escape:
+        _dm.stopRender();
+        break;
       default:
         break;
       }
@@ -22,6 +22,30 @@
 
 #include <iostream>
 
+// Messages above RAYTRACER_LOG_LEVEL are compiled out. Debug messages are
+// the setup ones shown with -d, trace messages are per ray and only exist
+// in `make debug` builds.
+#define RAYTRACER_LOG_LEVEL_NONE 0
+#define RAYTRACER_LOG_LEVEL_DEBUG 1
+#define RAYTRACER_LOG_LEVEL_TRACE 2
+
+#ifndef RAYTRACER_LOG_LEVEL
+#define RAYTRACER_LOG_LEVEL RAYTRACER_LOG_LEVEL_DEBUG
+#endif
+
+// The arguments are only evaluated when the message is compiled in and
+// debug output is enabled, so hot paths can log expensive expressions
+#define RAYTRACER_LOG_AT(level, ...)                              \
+    do {                                                          \
+        if constexpr ((level) <= RAYTRACER_LOG_LEVEL) {           \
+            if (::Raytracer::Debug::isEnabled())                  \
+                ::Raytracer::Debug::write(__VA_ARGS__);           \
+        }                                                         \
+    } while (0)
+
+#define RT_LOG_DEBUG(...) RAYTRACER_LOG_AT(RAYTRACER_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define RT_LOG_TRACE(...) RAYTRACER_LOG_AT(RAYTRACER_LOG_LEVEL_TRACE, __VA_ARGS__)
+
 namespace Raytracer {
 
 class Debug {
@@ -32,13 +56,21 @@ public:
     static void setEnabled(bool enable) { enabled = enable; }
     static bool isEnabled() { return enabled; }
 
+    // Cold paths only, the arguments are always evaluated
     template <typename... Args>
-    static void log(Args... args)
+    static void log(const Args&... args)
     {
-        if (enabled) {
-            (std::cout << ... << args) << std::endl;
+        if constexpr (RAYTRACER_LOG_LEVEL >= RAYTRACER_LOG_LEVEL_DEBUG) {
+            if (enabled)
+                write(args...);
         }
     }
+
+    template <typename... Args>
+    static void write(const Args&... args)
+    {
+        (std::cout << ... << args) << std::endl;
+    }
 };
 
 }
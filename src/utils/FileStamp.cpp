@@ -0,0 +1,68 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** FileStamp.cpp
+*/
+
+#include "FileStamp.hpp"
+#include "MappedFile.hpp"
+#include <stdexcept>
+#include <sys/stat.h>
+
+namespace Raytracer {
+
+namespace {
+
+    bool statFile(const std::string& path, std::uint64_t& size, std::int64_t& time)
+    {
+        struct stat info;
+        if (stat(path.c_str(), &info) < 0)
+            return false;
+        size = static_cast<std::uint64_t>(info.st_size);
+        time = static_cast<std::int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+        return true;
+    }
+
+    std::uint64_t hashFile(const std::string& path)
+    {
+        MappedFile file(path);
+        return hashBytes(file.data(), file.size());
+    }
+
+} // namespace
+
+std::uint64_t hashBytes(const void* data, std::size_t size, std::uint64_t hash)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+FileStamp FileStamp::of(const std::string& path)
+{
+    FileStamp stamp;
+    if (!statFile(path, stamp.size, stamp.time))
+        throw std::runtime_error("Failed to open file: " + path);
+    stamp.hash = hashFile(path);
+    return stamp;
+}
+
+bool FileStamp::matches(const std::string& path)
+{
+    std::uint64_t currentSize;
+    std::int64_t currentTime;
+    if (!statFile(path, currentSize, currentTime) || currentSize != size)
+        return false;
+    if (currentTime == time)
+        return true;
+    if (hashFile(path) != hash)
+        return false;
+    time = currentTime;
+    return true;
+}
+
+} // namespace Raytracer
@@ -0,0 +1,41 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** FileStamp.hpp
+*/
+
+#ifndef RAYTRACER_FILESTAMP_HPP
+#define RAYTRACER_FILESTAMP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Raytracer {
+
+// 64-bit FNV-1a of size bytes. Passing the result of a previous call as
+// hash chains several buffers into one hash.
+std::uint64_t hashBytes(const void* data, std::size_t size,
+    std::uint64_t hash = 0xcbf29ce484222325ull);
+
+// Identity of a source file recorded by the caches built from it. Written
+// as is in cache headers, so it only holds fixed-size fields.
+struct FileStamp {
+    std::uint64_t size = 0;
+    std::int64_t time = 0; // Modification time, nanoseconds since the epoch
+    std::uint64_t hash = 0; // 64-bit FNV-1a of the contents
+
+    // Stamp of the file at path. Throws std::runtime_error when it cannot
+    // be read.
+    static FileStamp of(const std::string& path);
+
+    // True when the file at path still has the stamped contents. The hash
+    // is only computed when the size matches but the time differs (after a
+    // copy or a checkout), and a match then takes the new time.
+    bool matches(const std::string& path);
+};
+
+} // namespace Raytracer
+
+#endif /* RAYTRACER_FILESTAMP_HPP */
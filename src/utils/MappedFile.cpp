@@ -0,0 +1,65 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** MappedFile.cpp
+*/
+
+#include "MappedFile.hpp"
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Raytracer {
+
+namespace {
+
+    int adviceFor(MappedFile::Access access)
+    {
+        switch (access) {
+        case MappedFile::Access::Random:
+            return MADV_RANDOM;
+        case MappedFile::Access::WillNeed:
+            return MADV_WILLNEED;
+        default:
+            return MADV_SEQUENTIAL;
+        }
+    }
+
+} // namespace
+
+MappedFile::MappedFile(const std::string& path, Access access)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("Failed to open file: " + path);
+
+    struct stat info;
+    if (fstat(fd, &info) < 0) {
+        close(fd);
+        throw std::runtime_error("Failed to stat file: " + path);
+    }
+
+    _size = static_cast<std::size_t>(info.st_size);
+    if (_size > 0) {
+        void* data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("Failed to map file: " + path);
+        }
+        madvise(data, _size, adviceFor(access));
+        _data = static_cast<const char*>(data);
+    }
+    // The mapping keeps its own reference to the file
+    close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+    if (_data)
+        munmap(const_cast<char*>(_data), _size);
+}
+
+} // namespace Raytracer
@@ -0,0 +1,47 @@
+/*
+** EPITECH PROJECT, 2025
+** mirror_raytracer
+** File description:
+** MappedFile.hpp
+*/
+
+#ifndef RAYTRACER_MAPPEDFILE_HPP
+#define RAYTRACER_MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace Raytracer {
+
+// Read-only memory mapping of a whole file, unmapped on destruction. The
+// pages are read in lazily by the kernel instead of being copied through a
+// stream buffer.
+class MappedFile {
+public:
+    // How the pages will be read, passed on to the kernel as a hint
+    enum class Access {
+        Sequential, // Front to back once, read ahead and drop behind
+        Random, // Scattered reads, no read ahead
+        WillNeed, // All of it soon, start reading everything now
+    };
+
+    // Throws std::runtime_error when the file cannot be opened or mapped
+    explicit MappedFile(const std::string& path,
+        Access access = Access::Sequential);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // nullptr for an empty file
+    const char* data() const { return _data; }
+    std::size_t size() const { return _size; }
+
+private:
+    const char* _data = nullptr;
+    std::size_t _size = 0;
+};
+
+} // namespace Raytracer
+
+#endif /* RAYTRACER_MAPPEDFILE_HPP */
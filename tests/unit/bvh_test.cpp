@@ -0,0 +1,238 @@
+#include "../../src/core/BVH.hpp"
+#include "../../src/core/Cube.hpp"
+#include "../../src/core/Sphere.hpp"
+#include "../../src/core/TriangleMesh.hpp"
+#include "../../src/renderer/PrimitiveRenderer/PrimitiveRenderer.hpp"
+#include <criterion/criterion.h>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace Raytracer;
+using namespace Math;
+
+TestSuite(BVHTest);
+
+// Test bounding box of a translated sphere
+Test(BVHTest, SphereBoundingBox)
+{
+    Sphere sphere(Point3D(1, 2, 3), 2);
+    AABB box = sphere.getBoundingBox();
+
+    cr_assert_float_eq(box.min.x, -1.0, 1e-9, "Min X incorrect");
+    cr_assert_float_eq(box.max.z, 5.0, 1e-9, "Max Z incorrect");
+    cr_assert(box.isFinite(), "Sphere bounds should be finite");
+}
+
+// Test that every item ends up in exactly one leaf
+Test(BVHTest, BuildKeepsAllItems)
+{
+    std::vector<AABB> boxes;
+    for (int i = 0; i < 100; i++) {
+        boxes.push_back(AABB(Point3D(i, 0, 0), Point3D(i + 0.5, 1, 1)));
+    }
+
+    BVH bvh;
+    bvh.build(boxes);
+
+    std::vector<int> seen(boxes.size(), 0);
+    for (auto index : bvh.getIndices()) {
+        seen[index]++;
+    }
+    for (int count : seen) {
+        cr_assert_eq(count, 1, "Each box should be referenced once");
+    }
+}
+
+// Chain of interior nodes, each with three one-item leaves around the
+// next node, all sharing the same box
+static std::vector<BVH::Node> nodeChain(std::size_t length)
+{
+    std::vector<BVH::Node> nodes(length);
+    for (std::size_t i = 0; i < length; i++) {
+        for (int c = 0; c < BVH::WIDTH; c++) {
+            nodes[i].minX[c] = nodes[i].minY[c] = nodes[i].minZ[c] = -1;
+            nodes[i].maxX[c] = nodes[i].maxY[c] = nodes[i].maxZ[c] = 1;
+            nodes[i].child[c] = 0;
+            nodes[i].count[c] = 1;
+        }
+        if (i + 1 < length) {
+            nodes[i].child[BVH::WIDTH - 1] = static_cast<std::uint32_t>(i + 1);
+            nodes[i].count[BVH::WIDTH - 1] = 0;
+        }
+    }
+    return nodes;
+}
+
+// Test that the deepest tree restore accepts fits the traversal stacks
+Test(BVHTest, RestoreLimitsDepth)
+{
+    AABB bounds(Point3D(-1, -1, -1), Point3D(1, 1, 1));
+    BVH bvh;
+    bvh.restore(nodeChain(BVH::MAX_DEPTH), std::vector<std::uint32_t> { 0 }, bounds, 1);
+
+    // Every leaf is hit and none reports a hit, so the whole chain is
+    // walked with the stack at its fullest
+    Ray ray(Point3D(0, 0, -5), Vector3D(0, 0, 1));
+    double tMax = 100;
+    std::size_t leaves = 0;
+    bvh.intersectLeaves(ray, tMax, [&](std::uint32_t, std::uint16_t, double&) {
+        leaves++;
+        return false;
+    });
+    cr_assert_eq(leaves, (BVH::WIDTH - 1) * BVH::MAX_DEPTH + 1);
+
+    std::size_t tested = 0;
+    bvh.occluded(ray, tMax, [&](std::uint32_t, double) {
+        tested++;
+        return false;
+    });
+    cr_assert_eq(tested, leaves);
+
+    BVH deeper;
+    cr_assert_throw(deeper.restore(nodeChain(BVH::MAX_DEPTH + 1),
+                        std::vector<std::uint32_t> { 0 }, bounds, 1),
+        std::invalid_argument);
+}
+
+// Test that the closest sphere along the ray is returned
+Test(BVHTest, ClosestIntersection)
+{
+    std::vector<std::unique_ptr<IPrimitive>> primitives;
+    for (int i = 0; i < 20; i++) {
+        primitives.push_back(std::make_unique<Sphere>(Point3D(0, 0, -5.0 * (i + 1)), 1));
+    }
+
+    PrimitiveRenderer renderer(primitives);
+    IntersectionInfo info;
+    Ray ray(Point3D(0, 0, 0), Vector3D(0, 0, -1));
+
+    IPrimitive* hit = renderer.findClosestIntersection(ray, info);
+    cr_assert_eq(hit, primitives[0].get(), "Closest sphere should be hit");
+    cr_assert_float_eq(info.t, 4.0, 1e-6, "Hit distance incorrect");
+}
+
+// Test that a mesh reports the face it was hit on
+Test(BVHTest, MeshHitsElement)
+{
+    std::vector<float> x = { -1, 1, 0, -1, 1, 0 };
+    std::vector<float> y = { -1, -1, 1, -1, -1, 1 };
+    std::vector<float> z = { -2, -2, -2, -6, -6, -6 };
+    std::vector<std::uint32_t> indices = { 3, 4, 5, 0, 1, 2 };
+    TriangleMesh mesh(std::make_shared<const MeshData>(x, y, z, indices));
+
+    Ray ray(Point3D(0, 0, 0), Vector3D(0, 0, -1));
+    std::size_t element = 0;
+    double t = mesh.hitsElement(ray, element);
+
+    cr_assert_float_eq(t, 2.0, 1e-6, "Mesh should be hit on the nearest face");
+    cr_assert_eq(element, 1, "Nearest face is the second one");
+    cr_assert_float_eq(mesh.getElementNormal(ray.at(t), element).z, 1.0, 1e-6,
+        "Face normal should follow the winding order");
+}
+
+// Test that instances sharing one mesh are each placed by their transform
+Test(BVHTest, MeshInstancesShareGeometry)
+{
+    std::vector<float> x = { -1, 1, 0 };
+    std::vector<float> y = { -1, -1, 1 };
+    std::vector<float> z = { 0, 0, 0 };
+    auto data = std::make_shared<const MeshData>(x, y, z, std::vector<std::uint32_t> { 0, 1, 2 });
+    TriangleMesh moved(data, nullptr, Transform(Vector3D(0, 0, 0), Vector3D(0, 0, -5)));
+    TriangleMesh turned(data, nullptr, Transform(Vector3D(0, M_PI / 2, 0), Vector3D(3, 0, -5)));
+    cr_assert_eq(&moved.getMesh(), &turned.getMesh(), "Instances should share their mesh");
+
+    Ray front(Point3D(0, 0, 0), Vector3D(0, 0, -1));
+    std::size_t element = 0;
+    double t = moved.hitsElement(front, element);
+    cr_assert_float_eq(t, 5.0, 1e-6, "Translated instance hit distance incorrect");
+    cr_assert_float_eq(moved.getElementNormal(front.at(t), element).z, 1.0, 1e-6);
+
+    Ray side(Point3D(10, 0, -5), Vector3D(-1, 0, 0));
+    t = turned.hitsElement(side, element);
+    cr_assert_float_eq(t, 7.0, 1e-6, "Rotated instance hit distance incorrect");
+    cr_assert_float_eq(turned.getElementNormal(side.at(t), element).x, 1.0, 1e-6,
+        "Normal should turn with the instance");
+    cr_assert_lt(turned.hits(front), 0.0, "Rotated instance lies off this ray");
+
+    AABB box = turned.getBoundingBox();
+    cr_assert(box.min.x <= 3 && box.max.x >= 3 && box.min.z <= -6 && box.max.z >= -4,
+        "Instance box should hold the rotated face");
+}
+
+// Test that a packet finds the same hits as its rays traced one by one
+Test(BVHTest, PacketMatchesSingleRays)
+{
+    std::vector<std::unique_ptr<IPrimitive>> primitives;
+    for (int i = 0; i < 20; i++) {
+        primitives.push_back(std::make_unique<Sphere>(Point3D(i % 5 - 2.0, i / 5 - 1.5, -6.0 - i), 0.6));
+    }
+    primitives.push_back(std::make_unique<Cube>(Point3D(0, 0, -30), 8));
+
+    PrimitiveRenderer renderer(primitives);
+    RayPacket packet;
+    packet.count = 5;
+    for (int i = 0; i < packet.count; i++) {
+        packet.set(i, Ray(Point3D(0, 0, 0), Vector3D(0.1 * i - 0.2, 0.05 * i, -1).normalize()));
+    }
+    packet.pad();
+
+    IPrimitive* hits[RayPacket::SIZE];
+    IntersectionInfo infos[RayPacket::SIZE];
+    renderer.findClosestPacket(packet, hits, infos);
+
+    for (int i = 0; i < packet.count; i++) {
+        IntersectionInfo info;
+        IPrimitive* hit = renderer.findClosestIntersection(packet.ray(i), info);
+        cr_assert_eq(hits[i], hit, "Lane %d should hit the same primitive", i);
+        if (hit) {
+            cr_assert_eq(infos[i].t, info.t, "Lane %d hit distance differs", i);
+        }
+    }
+}
+
+// Test that the wide node traversal finds the same hits as a linear search
+Test(BVHTest, ClosestMatchesLinearSearch)
+{
+    std::vector<std::unique_ptr<IPrimitive>> primitives;
+    for (int i = 0; i < 200; i++) {
+        primitives.push_back(std::make_unique<Sphere>(
+            Point3D((i * 37 % 41) - 20.0, (i * 13 % 23) - 11.0, -10.0 - (i * 7 % 19)), 0.8));
+    }
+
+    PrimitiveRenderer renderer(primitives);
+    for (int i = 0; i < 100; i++) {
+        Ray ray(Point3D(0, 0, 0), Vector3D((i % 10) * 0.2 - 0.9, (i / 10) * 0.1 - 0.45, -1).normalize());
+        double closest = -1;
+        for (const auto& prim : primitives) {
+            double t = prim->hits(ray);
+            if (t > 0 && (closest < 0 || t < closest)) {
+                closest = t;
+            }
+        }
+
+        IntersectionInfo info;
+        IPrimitive* hit = renderer.findClosestIntersection(ray, info);
+        cr_assert_eq(hit != nullptr, closest > 0, "Ray %d hit mismatch", i);
+        if (hit) {
+            cr_assert_float_eq(info.t, closest, 1e-9, "Ray %d hit distance differs", i);
+        }
+    }
+}
+
+// Test that rays through the edge shared by two faces never slip between them
+Test(BVHTest, MeshIsWatertight)
+{
+    std::vector<float> x = { -1, 1, 1, -1 };
+    std::vector<float> y = { -1, -1, 1, 1 };
+    std::vector<float> z = { -2, -2.5f, -2, -1.5f };
+    std::vector<std::uint32_t> indices = { 0, 1, 2, 0, 2, 3 };
+    TriangleMesh mesh(std::make_shared<const MeshData>(x, y, z, indices));
+
+    for (int i = 1; i < 1000; i++) {
+        double s = -1.0 + i / 500.0;
+        Ray ray(Point3D(0.1, -0.2, 0.3), (Point3D(s, s, -2) - Point3D(0.1, -0.2, 0.3)).normalize());
+        std::size_t element = 0;
+        cr_assert_gt(mesh.hitsElement(ray, element), 0.0, "Ray %d leaked through the diagonal", i);
+    }
+}
@@ -0,0 +1,65 @@
+#include "../../src/builders/MeshCache.hpp"
+#include "../../src/builders/ObjLoader.hpp"
+#include <chrono>
+#include <criterion/criterion.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+using namespace Raytracer;
+
+TestSuite(MeshCacheTest);
+
+static void writeGrid(const std::string& path, int size)
+{
+    std::ofstream out(path);
+    for (int y = 0; y <= size; y++) {
+        for (int x = 0; x <= size; x++)
+            out << "v " << x << " " << y << " " << (x * y) % 3 * 0.1 << "\n";
+    }
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            int a = y * (size + 1) + x + 1;
+            out << "f " << a << " " << a + 1 << " " << a + size + 2 << " " << a + size + 1 << "\n";
+        }
+    }
+}
+
+// Test that a saved mesh maps back with the same geometry and BVH, that
+// touching the source file keeps it and that editing it invalidates it
+Test(MeshCacheTest, RoundTripAndInvalidation)
+{
+    std::string path = (std::filesystem::temp_directory_path() / "mesh_cache_test.obj").string();
+    writeGrid(path, 12);
+
+    ObjMesh obj = ObjLoader::load(path);
+    MeshData mesh(obj.x, obj.y, obj.z, obj.indices, obj.normals);
+    MeshCache::save(path, mesh);
+    std::shared_ptr<const MeshData> cached = MeshCache::load(path);
+
+    cr_assert(cached != nullptr, "Cache was not loaded back");
+    cr_assert_eq(cached->getTriangleCount(), mesh.getTriangleCount());
+    cr_assert_eq(cached->getBuffers().bvh.getNodes().size(), mesh.getBuffers().bvh.getNodes().size());
+    for (int i = 0; i < 100; i++) {
+        Ray ray(Math::Point3D(0.13 * i, 0.07 * i, 5), Math::Vector3D(0.01, 0.02, -1).normalize());
+        std::size_t a = 0, b = 0;
+        cr_assert_eq(mesh.intersect(ray, a), cached->intersect(ray, b), "Ray %d differs", i);
+        cr_assert_eq(a, b, "Ray %d hit another face", i);
+    }
+
+    // A new time with the same contents refreshes the cache, which leaves
+    // meshes mapped from the old file intact
+    std::filesystem::last_write_time(path,
+        std::filesystem::last_write_time(path) + std::chrono::hours(1));
+    cr_assert(MeshCache::load(path) != nullptr, "Touched source invalidated the cache");
+    cr_assert(MeshCache::load(path) != nullptr, "Refreshed cache was not loaded back");
+    Ray ray(Math::Point3D(3.3, 4.4, 5), Math::Vector3D(0, 0, -1));
+    std::size_t face = 0;
+    cr_assert(cached->intersect(ray, face), "Mapped mesh broke after the refresh");
+
+    writeGrid(path, 13);
+    cr_assert(MeshCache::load(path) == nullptr, "Stale cache was used");
+
+    std::remove(path.c_str());
+    std::remove(MeshCache::pathFor(path).c_str());
+}
@@ -0,0 +1,87 @@
+#include "../../src/builders/ObjLoader.hpp"
+#include <criterion/criterion.h>
+#include <string>
+#include <vector>
+
+using namespace Raytracer;
+
+TestSuite(ObjLoaderTest);
+
+static ObjMesh parse(const std::string& text, int threads = 1)
+{
+    return ObjLoader::parse(text.data(), text.size(), threads);
+}
+
+// Test that polygons are split into a fan around their first corner
+Test(ObjLoaderTest, NGonsAreFanTriangulated)
+{
+    ObjMesh mesh = parse("# pentagon\r\n"
+                         "v 0 0 0\nv 1 0 0\nv 1.5 1 0\nv 0.5 2 0\nv -0.5 1 0\n"
+                         "vt 0 0\n"
+                         "f 1/1 2/1 3/1 4/1 5/1\n");
+
+    std::vector<std::uint32_t> expected = { 0, 1, 2, 0, 2, 3, 0, 3, 4 };
+    cr_assert_eq(mesh.x.size(), 5);
+    cr_assert(mesh.indices == expected, "Pentagon was not split into a fan");
+    cr_assert_float_eq(mesh.x[2], 1.5f, 1e-6);
+    cr_assert_float_eq(mesh.y[3], 2.0f, 1e-6);
+    cr_assert(mesh.normals.indices.empty(), "Normals reported for a file without any");
+}
+
+// Test that negative indices count back from the last vertex read
+Test(ObjLoaderTest, NegativeIndices)
+{
+    ObjMesh mesh = parse("v 0 0 0\nv 1 0 0\nv 0 1 0\nvn 0 0 1\n"
+                         "f -3//-1 -2//-1 -1//-1\n"
+                         "v 1 1 0\n"
+                         "f 2//1 -1//1 3//1\n");
+
+    std::vector<std::uint32_t> expected = { 0, 1, 2, 1, 3, 2 };
+    cr_assert(mesh.indices == expected, "Relative indices resolved wrongly");
+    cr_assert_eq(mesh.normals.indices.size(), 6);
+    for (std::uint32_t index : mesh.normals.indices)
+        cr_assert_eq(index, 0);
+}
+
+// Test that faces referencing missing vertices are dropped on their own
+Test(ObjLoaderTest, InvalidFacesAreSkipped)
+{
+    ObjMesh mesh = parse("v 0 0 0\nv 1 0 0\nv 0 1 0\n"
+                         "f 1 2 7\nf 1 2\nf 0 1 2\nf -9 1 2\nf 1 2 3\n");
+
+    std::vector<std::uint32_t> expected = { 0, 1, 2 };
+    cr_assert(mesh.indices == expected, "Invalid faces were kept");
+    cr_assert_eq(mesh.invalidFaces, 4);
+}
+
+// Test that a comment at the end of a line is not read as data
+Test(ObjLoaderTest, TrailingCommentsAreIgnored)
+{
+    ObjMesh mesh = parse("v 0 0 0 # origin\nv 1 0 0\nv 0 1 0\nv 1 1 0\n"
+                         "f 1 2 3 # first\nf 2 4 3#second\n# f 1 2 4\n");
+
+    std::vector<std::uint32_t> expected = { 0, 1, 2, 1, 3, 2 };
+    cr_assert(mesh.indices == expected, "Commented faces parsed wrongly");
+    cr_assert_eq(mesh.invalidFaces, 0);
+}
+
+// Test that cutting the file between threads does not change the result,
+// including relative indices reaching into an earlier chunk
+Test(ObjLoaderTest, ParallelParseMatchesSerial)
+{
+    std::string text;
+    for (int row = 0; row < 100000; row++) {
+        text += "v " + std::to_string(row) + " 0.25 -1e-3\n";
+        text += "v " + std::to_string(row) + " 1.5 2\n";
+        if (row > 0)
+            text += "f -4 -3 -1 -2\n";
+    }
+
+    ObjMesh serial = parse(text, 1);
+    ObjMesh parallel = parse(text, 4);
+    cr_assert_eq(serial.indices.size(), 6 * 99999);
+    cr_assert(serial.x == parallel.x && serial.y == parallel.y && serial.z == parallel.z,
+        "Vertices differ between serial and parallel parsing");
+    cr_assert(serial.indices == parallel.indices,
+        "Faces differ between serial and parallel parsing");
+}
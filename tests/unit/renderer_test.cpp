@@ -0,0 +1,100 @@
+#include "../../src/core/PointLight.hpp"
+#include "../../src/core/Sphere.hpp"
+#include "../../src/material/CompositeMaterial.hpp"
+#include "../../src/material/GlassMaterial.hpp"
+#include "../../src/material/MatteMaterial.hpp"
+#include "../../src/material/MirrorMaterial.hpp"
+#include "../../src/renderer/Renderer.hpp"
+#include "../../src/sampler/RandomSampler.hpp"
+#include <criterion/criterion.h>
+#include <memory>
+#include <stdexcept>
+
+using namespace Raytracer;
+
+TestSuite(RendererTest);
+
+static SceneBuilder mixedScene()
+{
+    SceneBuilder scene;
+    scene.setCamera(Math::Point3D(0, 0, 0));
+    scene.setScreen(32, 18);
+    scene.getCamera().setFieldOfView(60);
+
+    auto composite = std::make_unique<CompositeMaterial>(Math::Vector3D(0.5, 0.5, 0.5));
+    composite->addMaterial(std::make_unique<GlassMaterial>(Math::Vector3D(0.9, 0.9, 1.0)), 0.6);
+    composite->addMaterial(std::make_unique<MatteMaterial>(Math::Vector3D(0.8, 0.3, 0.2)), 0.4);
+
+    scene.addPrimitive(std::make_unique<Sphere>(Math::Point3D(-1.2, 0, -6), 1,
+        std::make_unique<MirrorMaterial>(Math::Vector3D(0.9, 0.9, 0.9))));
+    scene.addPrimitive(std::make_unique<Sphere>(Math::Point3D(1.2, 0, -6), 1,
+        std::make_unique<GlassMaterial>(Math::Vector3D(0.9, 0.95, 1.0))));
+    scene.addPrimitive(std::make_unique<Sphere>(Math::Point3D(0, 1.5, -7), 1, std::move(composite)));
+    scene.addPrimitive(std::make_unique<Sphere>(Math::Point3D(0, -101, -6), 100,
+        std::make_unique<MatteMaterial>(Math::Vector3D(0.4, 0.7, 0.4))));
+    scene.addLight(std::make_unique<PointLight>(Math::Point3D(5, 5, 0), 0.8f, 0.001f));
+    return scene;
+}
+
+// Test that the wavefront engine renders the recursive engine's image
+Test(RendererTest, WavefrontMatchesRecursive)
+{
+    Renderer recursive(mixedScene(), 32, 18, 6, 2, 1);
+    Renderer wavefront(mixedScene(), 32, 18, 6, 2, 1);
+
+    wavefront.setEngine(RenderEngine::Wavefront);
+    recursive.render();
+    wavefront.render();
+
+    for (int y = 0; y < 18; y++) {
+        for (int x = 0; x < 32; x++) {
+            Math::Vector3D a = recursive.getFrameBuffer().getPixel(x, y);
+            Math::Vector3D b = wavefront.getFrameBuffer().getPixel(x, y);
+            cr_assert_float_eq(a.x, b.x, 1e-4, "Red differs at %d, %d", x, y);
+            cr_assert_float_eq(a.y, b.y, 1e-4, "Green differs at %d, %d", x, y);
+            cr_assert_float_eq(a.z, b.z, 1e-4, "Blue differs at %d, %d", x, y);
+        }
+    }
+}
+
+// Tracer that only hands out samples; matte materials never trace rays
+class SamplingTracer : public ITracer {
+public:
+    Math::Vector3D trace(const Ray&, int, double) override
+    {
+        return Math::Vector3D(0, 0, 0);
+    }
+
+    ISampler& getSampler() override { return sampler; }
+
+    RandomSampler sampler { 42 };
+};
+
+// Test that picking one sub-material per sample averages to the blend
+Test(RendererTest, StochasticCompositeMatchesBlend)
+{
+    CompositeMaterial composite(Math::Vector3D(0.5, 0.5, 0.5));
+    composite.addMaterial(std::make_unique<MatteMaterial>(Math::Vector3D(1, 0, 0)), 0.5);
+    composite.addMaterial(std::make_unique<MatteMaterial>(Math::Vector3D(0, 1, 0)), 0.3);
+    composite.addMaterial(std::make_unique<MatteMaterial>(Math::Vector3D(0, 0, 1)), 0.2);
+    cr_assert_throw(composite.addMaterial(
+                        std::make_unique<MatteMaterial>(Math::Vector3D(1, 1, 1)), 0.0),
+        std::invalid_argument);
+
+    SamplingTracer tracer;
+    Ray ray(Math::Point3D(0, 0, 0), Math::Vector3D(0, 0, -1));
+    IntersectionInfo hit { Math::Point3D(0, 0, -1), Math::Vector3D(0, 0, 1), true, 1.0 };
+    Math::Vector3D blend = composite.computeInteraction(ray, hit, tracer, 0);
+
+    composite.setStochastic(true);
+    const int samples = 20000;
+    Math::Vector3D sum(0, 0, 0);
+    for (int i = 0; i < samples; i++) {
+        tracer.sampler.startSample(0, 0, i);
+        sum += composite.computeInteraction(ray, hit, tracer, 0);
+    }
+    Math::Vector3D average = sum / samples;
+    cr_assert_float_eq(average.x, blend.x, 0.02, "Red average %f, blend %f", average.x, blend.x);
+    cr_assert_float_eq(average.y, blend.y, 0.02, "Green average %f, blend %f", average.y, blend.y);
+    cr_assert_float_eq(average.z, blend.z, 0.02, "Blue average %f, blend %f", average.z, blend.z);
+}
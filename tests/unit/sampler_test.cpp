@@ -0,0 +1,138 @@
+#include "../../src/factories/SamplerFactory.hpp"
+#include <criterion/criterion.h>
+#include <memory>
+#include <set>
+
+using namespace Raytracer;
+
+TestSuite(SamplerTest);
+
+// Test that a sample's sequence only depends on the pixel and sample index
+Test(SamplerTest, RandomSamplerIsReproducible)
+{
+    RandomSampler a(42);
+    RandomSampler b(42);
+
+    b.startSample(3, 4, 1);
+    b.next1D();
+    a.startSample(7, 7, 0);
+    a.next1D();
+
+    a.startSample(3, 4, 5);
+    b.startSample(3, 4, 5);
+    for (int i = 0; i < 16; i++)
+        cr_assert_eq(a.next1D(), b.next1D(), "Sequences diverged at %d", i);
+}
+
+// Test that neighbouring pixels and clones behave as expected
+Test(SamplerTest, RandomSamplerStreams)
+{
+    RandomSampler sampler(1);
+    std::unique_ptr<ISampler> copy = sampler.clone();
+
+    sampler.startSample(10, 10, 0);
+    double first = sampler.next1D();
+    sampler.startSample(11, 10, 0);
+    cr_assert_neq(first, sampler.next1D(), "Neighbouring pixels share a stream");
+
+    copy->startSample(10, 10, 0);
+    cr_assert_eq(first, copy->next1D(), "Clone lost the seed");
+}
+
+// Test that values stay in [0, 1) with a mean near one half
+Test(SamplerTest, RandomSamplerRange)
+{
+    RandomSampler sampler;
+    double sum = 0.0;
+    const int count = 10000;
+
+    sampler.startSample(0, 0, 0);
+    for (int i = 0; i < count; i++) {
+        double value = sampler.next1D();
+        cr_assert(value >= 0.0 && value < 1.0, "Value out of range");
+        sum += value;
+    }
+    cr_assert_float_eq(sum / count, 0.5, 0.02, "Biased sampler");
+}
+
+// Test that a pixel's samples hit every stratum exactly once
+Test(SamplerTest, StratifiedCoversEveryStratum)
+{
+    StratifiedSampler sampler(16, 3);
+    std::set<int> strata;
+    std::set<int> cells;
+
+    for (int i = 0; i < 16; i++) {
+        sampler.startSample(5, 9, i);
+        Sample2D position = sampler.next2D();
+        strata.insert(static_cast<int>(sampler.next1D() * 16));
+        cells.insert(static_cast<int>(position.u * 4) + 4 * static_cast<int>(position.v * 4));
+    }
+    cr_assert_eq(strata.size(), 16u, "1D strata missed");
+    cr_assert_eq(cells.size(), 16u, "2D grid cells missed");
+}
+
+// Test that the first 16 Sobol points form one point per 4x4 cell, the
+// (0, 2) property that scrambling must preserve
+Test(SamplerTest, SobolPrefixIsStratified)
+{
+    SobolSampler sampler(11);
+
+    for (int dimension = 0; dimension < 3; dimension++) {
+        std::set<int> cells;
+        for (int i = 0; i < 16; i++) {
+            sampler.startSample(2, 7, i);
+            for (int skip = 0; skip < dimension; skip++)
+                sampler.next2D();
+            Sample2D point = sampler.next2D();
+            cells.insert(static_cast<int>(point.u * 4) + 4 * static_cast<int>(point.v * 4));
+        }
+        cr_assert_eq(cells.size(), 16u, "Dimension pair %d is not stratified", dimension);
+    }
+}
+
+// Test that every Halton dimension stays in [0, 1)
+Test(SamplerTest, HaltonRange)
+{
+    HaltonSampler sampler;
+
+    for (int i = 0; i < 64; i++) {
+        sampler.startSample(i, 0, i);
+        for (int dimension = 0; dimension < 40; dimension++) {
+            double value = sampler.next1D();
+            cr_assert(value >= 0.0 && value < 1.0, "Value out of range");
+        }
+    }
+}
+
+// Test sampler creation by name
+Test(SamplerTest, FactoryCreatesByName)
+{
+    SamplerFactory::registerAllSamplers();
+
+    for (const char* name : { "random", "stratified", "halton", "sobol" })
+        cr_assert_not_null(SamplerFactory::createSampler(name, 16).get(), "%s missing", name);
+    cr_assert_throw(SamplerFactory::createSampler("grid", 16), std::runtime_error);
+}
+
+// Test that a saved dimension resumes the sequence where it was left
+Test(SamplerTest, SetDimensionResumesSequence)
+{
+    SamplerFactory::registerAllSamplers();
+
+    for (const char* name : { "random", "stratified", "halton", "sobol" }) {
+        std::unique_ptr<ISampler> sampler = SamplerFactory::createSampler(name, 16, 3);
+        sampler->startSample(5, 9, 2);
+        sampler->next2D();
+        sampler->next1D();
+        int saved = sampler->getDimension();
+        double expected = sampler->next1D();
+
+        sampler->startSample(0, 0, 0);
+        sampler->next1D();
+        sampler->startSample(5, 9, 2);
+        sampler->setDimension(saved);
+        cr_assert_eq(sampler->getDimension(), saved, "%s lost the dimension", name);
+        cr_assert_eq(sampler->next1D(), expected, "%s did not resume its sequence", name);
+    }
+}
@@ -0,0 +1,105 @@
+#include "../../src/builders/SceneCache.hpp"
+#include <criterion/criterion.h>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+using namespace Raytracer;
+
+TestSuite(SceneCacheTest);
+
+static std::vector<AABB> gridBoxes()
+{
+    std::vector<AABB> boxes;
+    for (int i = 0; i < 4000; i++) {
+        Math::Point3D min(i % 20, i / 20 % 20, i / 400);
+        boxes.push_back(AABB(min, Math::Point3D(min.x + 0.5, min.y + 0.5, min.z + 0.5)));
+    }
+    return boxes;
+}
+
+static std::string readFile(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+static void writeFile(const std::string& path, const std::string& contents)
+{
+    std::ofstream(path, std::ios::binary) << contents;
+}
+
+// Test that damaged cache files are rejected instead of being mapped:
+// a truncated file, a node pointing outside the tree, leaves holding
+// EMPTY entries and a tree deeper than the traversal stacks allow
+Test(SceneCacheTest, CorruptCachesAreRejected)
+{
+    std::string path = (std::filesystem::temp_directory_path() / "scene_cache_test.txt").string();
+    std::vector<std::string> sources = { path };
+    std::ofstream(path) << "camera: {};\n";
+
+    std::vector<AABB> boxes = gridBoxes();
+    BVH built;
+    built.build(boxes);
+    const Buffer<BVH::Node>& nodes = built.getNodes();
+    cr_assert_gt(nodes.size(), BVH::MAX_DEPTH, "Tree too small to hold an over-deep chain");
+
+    SceneCache::save(sources, boxes, built);
+    std::string cachePath = SceneCache::pathFor(path);
+    std::string saved = readFile(cachePath);
+    BVH cached;
+    cr_assert(SceneCache::load(sources, boxes, cached), "Intact cache was not loaded");
+
+    // The nodes are stored as they are in memory, starting with the root
+    std::size_t nodeOffset = saved.find(std::string(reinterpret_cast<const char*>(nodes.data()),
+        sizeof(BVH::Node)));
+    cr_assert_neq(nodeOffset, std::string::npos, "Root node not found in the cache");
+
+    writeFile(cachePath, saved.substr(0, saved.size() - 64));
+    BVH truncated;
+    cr_assert_not(SceneCache::load(sources, boxes, truncated), "Truncated cache was used");
+
+    BVH::Node root = nodes[0];
+    int slot = 0;
+    while (root.count[slot] > 0 || root.child[slot] == BVH::EMPTY)
+        slot++;
+    root.child[slot] = static_cast<std::uint32_t>(nodes.size());
+    std::string badChild = saved;
+    std::memcpy(&badChild[nodeOffset], &root, sizeof(root));
+    writeFile(cachePath, badChild);
+    BVH outside;
+    cr_assert_not(SceneCache::load(sources, boxes, outside), "Child index past the tree was used");
+
+    // The indices close the file, padding would be EMPTY already
+    std::string emptyLeaves = saved;
+    std::size_t indexBytes = built.getIndices().size() * sizeof(std::uint32_t);
+    std::memset(&emptyLeaves[saved.size() - indexBytes], 0xff, indexBytes);
+    writeFile(cachePath, emptyLeaves);
+    BVH missing;
+    cr_assert_not(SceneCache::load(sources, boxes, missing), "Leaf of EMPTY entries was used");
+
+    // Same node count, but chained one below the other
+    std::string chain = saved;
+    for (std::size_t i = 0; i < nodes.size(); i++) {
+        BVH::Node node = nodes[0];
+        for (int c = 0; c < BVH::WIDTH; c++) {
+            node.child[c] = 0;
+            node.count[c] = 1;
+        }
+        if (i + 1 < nodes.size()) {
+            node.child[BVH::WIDTH - 1] = static_cast<std::uint32_t>(i + 1);
+            node.count[BVH::WIDTH - 1] = 0;
+        }
+        std::memcpy(&chain[nodeOffset + i * sizeof(BVH::Node)], &node, sizeof(node));
+    }
+    writeFile(cachePath, chain);
+    BVH deep;
+    cr_assert_not(SceneCache::load(sources, boxes, deep), "Over-deep tree was used");
+
+    std::remove(path.c_str());
+    std::remove(cachePath.c_str());
+    std::filesystem::remove(std::filesystem::path(cachePath).parent_path());
+}